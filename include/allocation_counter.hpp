@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace nsgaii
+{
+   // operator newの呼び出し回数・確保量を数える計測用フック
+   // allocation_counterライブラリをリンクした実行ファイルでのみ有効
+   struct AllocationCounter
+   {
+      static uint64_t count();
+      static uint64_t bytes();
+   };
+} // namespace nsgaii
@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+#error "baked_parameters.hppは焼き込み版（CHARGE_SCHEDULE_BAKED_PARAMS）でのみ使う"
+#endif
+
+#include <array>
+
+#include "nsgaii.hpp"
+#include "termination.hpp"
+
+// param_bakerがYAMLから生成した値（charge_schedule::baked名前空間の定数）
+#include "baked_parameter_values.hpp"
+
+namespace charge_schedule
+{
+    namespace baked
+    {
+        static_assert(visited_number == 2, "TwoTransProblemは2つの訪問先を前提とする");
+
+        // TwoTransProblemのコンストラクタと同じ式・同じ順序で計算する（実行時に計算した値とビット単位で一致する）
+        constexpr float T_cycle = [] {
+            float value = 0;
+            for (int i = 0; i < visited_number; ++i) value += T_move[i] + T_standby[i];
+            return value;
+        }();
+        constexpr float E_cycle = [] {
+            float value = 0;
+            for (int i = 0; i < visited_number; ++i) value += E_move[i] + E_standby[i];
+            return value;
+        }();
+        constexpr std::array<float, 4> T_timing = {T_move[1] + T_standby[1] + T_move[0], 0, T_standby[1] + T_move[0], T_move[1]};
+        constexpr std::array<float, 4> E_timing = {E_move[1] + E_standby[1] + E_move[0], 0, E_standby[1] + E_move[0], E_move[1]};
+
+        inline nsgaii::ScheduleParameters scheduleParameters() {
+            nsgaii::ScheduleParameters parameters;
+            parameters.T_move.assign(T_move.begin(), T_move.end());
+            parameters.T_standby.assign(T_standby.begin(), T_standby.end());
+            parameters.T_cs.assign(T_cs.begin(), T_cs.end());
+            parameters.E_move.assign(E_move.begin(), E_move.end());
+            parameters.E_standby.assign(E_standby.begin(), E_standby.end());
+            parameters.E_cs.assign(E_cs.begin(), E_cs.end());
+            parameters.visited_number = visited_number;
+            parameters.population_size = population_size;
+            parameters.T_max = T_max;
+            parameters.max_charge_number = max_charge_number;
+            parameters.W_target = W_target;
+            parameters.SOC_Hi = SOC_Hi;
+            parameters.SOC_Low = SOC_Low;
+            parameters.SOC_cccv = SOC_cccv;
+            parameters.r_cc = r_cc;
+            parameters.r_cv = r_cv;
+            parameters.charging_minimum = charging_minimum;
+            parameters.eta_sbx = eta_sbx;
+            parameters.eta_m = eta_m;
+            parameters.mutation_probability = mutation_probability;
+            parameters.survivor_selection = survivor_selection;
+            parameters.initial_sampler = initial_sampler;
+            parameters.crossover_mode = crossover_mode;
+            parameters.worker_threads = worker_threads;
+            parameters.initial_threads = initial_threads;
+            parameters.hv_reference = {hv_reference[0], hv_reference[1]};
+            return parameters;
+        }
+
+        inline nsgaii::TerminationParameters terminationParameters() {
+            nsgaii::TerminationParameters parameters;
+            parameters.enabled = termination_enabled;
+            parameters.window = termination_window;
+            parameters.hv_tolerance = termination_hv_tolerance;
+            parameters.front_stability = termination_front_stability;
+            parameters.diversity_minimum = termination_diversity_minimum;
+            parameters.max_restarts = termination_max_restarts;
+            parameters.restart_elite_ratio = termination_restart_elite_ratio;
+            return parameters;
+        }
+    } // namespace baked
+} // namespace charge_schedule
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace nsgaii
+{
+   // 容量付きのスレッド間キュー（ヘッダオンリー）
+   // 満杯ならpushが，空ならpopが待つことで，段の速さの違いを背圧として伝える
+   // 待ち時間と深さを記録し，パイプラインの各段の占有率を調べられるようにする
+   template <typename T>
+   class BoundedQueue
+   {
+   public:
+      explicit BoundedQueue(std::size_t capacity) : capacity_(std::max<std::size_t>(1, capacity)) {}
+
+      void push(T item) {
+         std::unique_lock<std::mutex> lock(mutex);
+         if (items.size() >= capacity_) {
+            auto start = std::chrono::steady_clock::now();
+            not_full.wait(lock, [this] { return items.size() < capacity_; });
+            push_wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         }
+         items.push_back(std::move(item));
+         max_depth = std::max(max_depth, items.size());
+         depth_sum += items.size();
+         ++pushes;
+         lock.unlock();
+         not_empty.notify_one();
+      }
+
+      T pop() {
+         std::unique_lock<std::mutex> lock(mutex);
+         if (items.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            not_empty.wait(lock, [this] { return !items.empty(); });
+            pop_wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         }
+         T item = std::move(items.front());
+         items.pop_front();
+         lock.unlock();
+         not_full.notify_one();
+         return item;
+      }
+
+      std::size_t capacity() const { return capacity_; }
+
+      // 以下の統計はpush・popと並行に呼んでもよい
+      std::size_t maxDepth() const { std::lock_guard<std::mutex> lock(mutex); return max_depth; }
+      double meanDepth() const { std::lock_guard<std::mutex> lock(mutex); return pushes ? static_cast<double>(depth_sum) / pushes : 0.0; }
+      double pushWaitSeconds() const { std::lock_guard<std::mutex> lock(mutex); return push_wait_seconds; }
+      double popWaitSeconds() const { std::lock_guard<std::mutex> lock(mutex); return pop_wait_seconds; }
+
+      void resetStatistics() {
+         std::lock_guard<std::mutex> lock(mutex);
+         max_depth = items.size();
+         depth_sum = 0;
+         pushes = 0;
+         push_wait_seconds = 0;
+         pop_wait_seconds = 0;
+      }
+
+   private:
+      const std::size_t capacity_;
+      mutable std::mutex mutex;
+      std::condition_variable not_full;
+      std::condition_variable not_empty;
+      std::deque<T> items;
+
+      std::size_t max_depth = 0;
+      std::size_t depth_sum = 0;   // push直後の深さの合計
+      std::size_t pushes = 0;
+      double push_wait_seconds = 0;
+      double pop_wait_seconds = 0;
+   };
+} // namespace nsgaii
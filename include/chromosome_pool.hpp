@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nsgaii
+{
+   // 個体の染色体・評価用ベクタのメモリブロックを再利用するプール
+   // ブロックは2のべき乗のサイズクラスごとにスレッド局所のフリーリストで保持し，
+   // 解放されたブロックを次の確保で使い回す．定常状態の世代ループではシステムからの確保が発生しない
+   // 別スレッドで解放されたブロックはそのスレッドのフリーリストに入り，上限を超えた分は共有の予備を通じて
+   // 確保する側のスレッドへ戻る（ワーカーで確保して呼び出しスレッドで解放する場合も確保が止まる）
+   class ChromosomePool
+   {
+   public:
+      struct Statistics
+      {
+         uint64_t system_allocations; // システム（operator new）から確保した回数
+         uint64_t reused_allocations; // フリーリストから再利用した回数
+         std::size_t cached_blocks;   // フリーリストに保持しているブロック数
+         std::size_t cached_bytes;    // フリーリストに保持しているバイト数
+      };
+
+      static void* allocate(std::size_t bytes);
+      static void deallocate(void* pointer, std::size_t bytes) noexcept;
+
+      // 呼び出しスレッドのプールの統計
+      static Statistics statistics();
+      // 全スレッドでシステムから確保した回数
+      static uint64_t totalSystemAllocations();
+      // 呼び出しスレッドのフリーリストと共有の予備に保持しているブロックをすべてシステムに返す
+      static void release();
+   };
+
+   template <typename T>
+   struct ChromosomeAllocator
+   {
+      using value_type = T;
+
+      ChromosomeAllocator() noexcept = default;
+      template <typename U>
+      ChromosomeAllocator(const ChromosomeAllocator<U>&) noexcept {}
+
+      T* allocate(std::size_t n) {
+         return static_cast<T*>(ChromosomePool::allocate(n * sizeof(T)));
+      }
+      void deallocate(T* pointer, std::size_t n) noexcept {
+         ChromosomePool::deallocate(pointer, n * sizeof(T));
+      }
+   };
+
+   // 状態を持たないのでどのインスタンス間でも確保・解放できる
+   template <typename T, typename U>
+   bool operator==(const ChromosomeAllocator<T>&, const ChromosomeAllocator<U>&) noexcept { return true; }
+   template <typename T, typename U>
+   bool operator!=(const ChromosomeAllocator<T>&, const ChromosomeAllocator<U>&) noexcept { return false; }
+
+   template <typename T>
+   using ChromosomeVector = std::vector<T, ChromosomeAllocator<T>>;
+} // namespace nsgaii
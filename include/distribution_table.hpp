@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace nsgaii
+{
+   // 分布指数etaに対する x^(1/(eta+1))（x∈[0,1]）の線形補間テーブル
+   // SBXの広がり係数βと多項式突然変異のδはどちらもこの関数で表せるため，
+   // etaが変わったときに1回だけpowを計算しておき，各遺伝子では一様乱数1つと補間のみで引く
+   class PowerTable
+   {
+   public:
+      explicit PowerTable(float eta = 0);
+
+      void build(float eta);
+      float eta() const { return eta_; }
+
+      // x^(1/(eta+1))．曲率が大きい原点付近（先頭kExactCells区間）のみpowで直接計算する
+      float operator()(float x) const;
+
+      // SBX: u ≤ 0.5 で (2u)^(1/(eta+1))，それ以外で (1/(2(1-u)))^(1/(eta+1))
+      float sbxBeta(float u) const {
+         return (u <= 0.5f) ? (*this)(2.0f * u) : 1.0f / (*this)(2.0f * (1.0f - u));
+      }
+      // 多項式突然変異: u < 0.5 で (2u)^(1/(eta+1)) - 1，それ以外で 1 - (2(1-u))^(1/(eta+1))
+      float mutationDelta(float u) const {
+         return (u < 0.5f) ? (*this)(2.0f * u) - 1.0f : 1.0f - (*this)(2.0f * (1.0f - u));
+      }
+
+      // 一様乱数の配列からまとめて値を求める（一括交叉用）
+      void sbxBetas(const float* u, float* beta, std::size_t n) const;
+      void mutationDeltas(const float* u, float* delta, std::size_t n) const;
+
+   private:
+      static constexpr int kResolution = 1024;
+      static constexpr int kExactCells = 16;
+
+      float eta_;
+      float exponent; // 1/(eta+1)
+      std::array<float, kResolution + 1> values;
+   };
+} // namespace nsgaii
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "nsgaii.hpp"
+
+namespace nsgaii
+{
+   // 最大充電回数MaxChargeをコンパイル時に固定した個体
+   // 遺伝子・評価用の配列をすべて内部に持つためトリビアルコピー可能で，memcpyや共有メモリでそのまま扱える
+   // 評価値・派生値も保持するので，Individualへ戻すときに復号・評価をやり直さない（乱数も使わない）
+   // 有効な要素数はcharging_number（T_spanなどはcharging_number + 1）
+   template <int MaxCharge>
+   struct FixedIndividual
+   {
+      static constexpr int capacity = MaxCharge;
+
+      int32_t charging_number;
+      int32_t penalty;
+      int32_t fronts_count;
+      int32_t first_soc;
+      float f1;
+      float f2;
+      float congestion;
+      float elapsed_time;
+      std::array<float, MaxCharge> time_chromosome;
+      std::array<int32_t, MaxCharge> soc_chromosome;
+      std::array<float, MaxCharge> E_return;
+      std::array<float, MaxCharge> soc_charging_start;
+      std::array<int32_t, MaxCharge> charging_position;
+      std::array<int32_t, MaxCharge> return_position;
+      std::array<std::array<float, 4>, MaxCharge + 1> T_span;
+      std::array<float, MaxCharge + 1> T_SOC_HiLow;
+      std::array<int32_t, MaxCharge + 1> W;
+      std::array<int32_t, MaxCharge + 1> cycle_count;
+   };
+
+   // ランタイムディスパッチで選べる容量
+   constexpr std::array<int, 4> kFixedCapacities = {8, 16, 32, 64};
+
+   namespace fixed_individual_detail
+   {
+      template <typename Source, typename Destination>
+      void copyElements(const Source& source, Destination& destination, std::size_t size) {
+         for (std::size_t i = 0; i < size; ++i) {
+            destination[i] = source[i];
+         }
+      }
+
+      template <typename Source, typename Destination>
+      void assignElements(const Source& source, Destination& destination, std::size_t size) {
+         destination.resize(size);
+         copyElements(source, destination, size);
+      }
+   } // namespace fixed_individual_detail
+
+   template <int MaxCharge>
+   void toFixed(const Individual& individual, FixedIndividual<MaxCharge>& fixed) {
+      std::size_t n = individual.charging_number;
+      if (individual.charging_number < 0 || n > static_cast<std::size_t>(MaxCharge)) {
+         std::cerr << "charging_numberが固定長個体の容量を超えています: " << n << " > " << MaxCharge << std::endl;
+         throw std::out_of_range("charging_number exceeds FixedIndividual capacity");
+      }
+      using fixed_individual_detail::copyElements;
+      fixed.charging_number = individual.charging_number;
+      fixed.penalty = individual.penalty;
+      fixed.fronts_count = individual.fronts_count;
+      fixed.first_soc = individual.first_soc;
+      fixed.f1 = individual.f1;
+      fixed.f2 = individual.f2;
+      fixed.congestion = individual.congestion;
+      fixed.elapsed_time = individual.elapsed_time;
+      copyElements(individual.time_chromosome, fixed.time_chromosome, n);
+      copyElements(individual.soc_chromosome, fixed.soc_chromosome, n);
+      copyElements(individual.E_return, fixed.E_return, n);
+      copyElements(individual.soc_charging_start, fixed.soc_charging_start, n);
+      copyElements(individual.charging_position, fixed.charging_position, n);
+      copyElements(individual.return_position, fixed.return_position, n);
+      copyElements(individual.T_span, fixed.T_span, n + 1);
+      copyElements(individual.T_SOC_HiLow, fixed.T_SOC_HiLow, n + 1);
+      copyElements(individual.W, fixed.W, n + 1);
+      copyElements(individual.cycle_count, fixed.cycle_count, n + 1);
+   }
+
+   template <int MaxCharge>
+   void fromFixed(const FixedIndividual<MaxCharge>& fixed, Individual& individual) {
+      std::size_t n = fixed.charging_number;
+      using fixed_individual_detail::assignElements;
+      individual.charging_number = fixed.charging_number;
+      individual.penalty = fixed.penalty;
+      individual.fronts_count = fixed.fronts_count;
+      individual.first_soc = fixed.first_soc;
+      individual.f1 = fixed.f1;
+      individual.f2 = fixed.f2;
+      individual.congestion = fixed.congestion;
+      individual.elapsed_time = fixed.elapsed_time;
+      assignElements(fixed.time_chromosome, individual.time_chromosome, n);
+      assignElements(fixed.soc_chromosome, individual.soc_chromosome, n);
+      assignElements(fixed.E_return, individual.E_return, n);
+      assignElements(fixed.soc_charging_start, individual.soc_charging_start, n);
+      assignElements(fixed.charging_position, individual.charging_position, n);
+      assignElements(fixed.return_position, individual.return_position, n);
+      assignElements(fixed.T_span, individual.T_span, n + 1);
+      assignElements(fixed.T_SOC_HiLow, individual.T_SOC_HiLow, n + 1);
+      assignElements(fixed.W, individual.W, n + 1);
+      assignElements(fixed.cycle_count, individual.cycle_count, n + 1);
+   }
+
+   // max_charge_number以上の最小の容量を選び，function(std::integral_constant<int, N>)を呼び出す
+   // 例: dispatchFixedCapacity(20, [](auto capacity) { FixedIndividual<capacity> fixed; ... });
+   template <typename Function>
+   decltype(auto) dispatchFixedCapacity(int max_charge_number, Function&& function) {
+      if (max_charge_number <= 8) return std::forward<Function>(function)(std::integral_constant<int, 8>{});
+      if (max_charge_number <= 16) return std::forward<Function>(function)(std::integral_constant<int, 16>{});
+      if (max_charge_number <= 32) return std::forward<Function>(function)(std::integral_constant<int, 32>{});
+      if (max_charge_number <= 64) return std::forward<Function>(function)(std::integral_constant<int, 64>{});
+      std::cerr << "max_charge_numberが固定長個体の最大容量を超えています: " << max_charge_number << std::endl;
+      throw std::out_of_range("max_charge_number exceeds the largest FixedIndividual capacity");
+   }
+
+   static_assert(std::is_trivially_copyable<FixedIndividual<8>>::value, "FixedIndividual must be trivially copyable");
+   static_assert(std::is_trivially_copyable<FixedIndividual<64>>::value, "FixedIndividual must be trivially copyable");
+} // namespace nsgaii
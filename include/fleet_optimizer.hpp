@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "nsgaii.hpp"
+#include "station_timeline.hpp"
+#include "two_point_trans_schedule.hpp"
+#include "work_stealing_pool.hpp"
+
+namespace charge_schedule
+{
+    struct FleetOptions
+    {
+        int thread_count = 0;          // 共有プールのスレッド数（0の場合はハードウェアスレッド数）
+        int max_generation = 100;      // 最大世代数
+        unsigned int base_seed = 0;    // ロボットrのシードはbase_seed + r
+        bool random_selection = true;  // generateChildrenのrandomフラグ
+        int evaluation_chunk = 16;     // 評価段で1タスクにまとめる個体数
+
+        // 充電ステーションの同時利用台数（添字は充電位置charging_position．空の場合は容量の制約なし）
+        std::vector<int> station_capacity;
+        float congestion_weight = 1.0f; // 混雑による待ち時間の見積もりに掛ける係数
+    };
+
+    struct RobotResult
+    {
+        std::vector<nsgaii::Individual> front; // 最終世代の第1前線（ペナルティなし）
+        double hypervolume;                    // 最終世代のアーカイブのハイパーボリューム
+        float congestion;                      // 採用予定のスケジュール（f1 + f2が最小の個体）の混雑による待ち時間
+    };
+
+    struct FleetResult
+    {
+        std::vector<RobotResult> robots;       // 入力のパラメータと同じ順
+        int generations;                       // 実行した世代数
+        long evaluations;                      // 全ロボットの評価回数
+        double elapsed_seconds;
+        std::vector<nsgaii::WorkStealingPool::WorkerStatistics> workers;
+    };
+
+    // 複数台のロボットの充電スケジュールを1プロセスでまとめて最適化する
+    // ロボットごとの問題（TwoTransProblem）は独立に持ち，世代ごとに次の3段を共有プールで実行する
+    //   変異段: ロボットごとに1タスク（選択・交叉・突然変異）
+    //   評価段: 全ロボットの子をつなげてevaluation_chunk個ずつのタスクに分ける
+    //           1台の個体数が少なくても，評価のタスクがロボットをまたいでワーカーに行き渡る
+    //   選択段: ロボットごとに1タスク（結合・非優越ソート・次世代の親の選択）
+    // 各ロボットは自身の乱数エンジンだけを使うので，スレッド数によらず1台ずつ実行した結果と一致する
+    //
+    // station_capacityを指定すると，ロボット間で充電ステーションを共有する
+    // 選択段の後に各ロボットの採用予定のスケジュール（第1前線のうちf1 + f2が最小の個体）を選び，
+    // その充電区間から次の世代のStationTimelineを作る．評価段では他のロボットの区間だけを数えた
+    // 最大占有数が容量を超える充電ごとに，超過台数 × 区間長 / 容量を待ち時間としてf1に加える
+    // 混雑は他のロボットの計画によって変わるので，親のf1も世代ごとに見積もり直す
+    class FleetOptimizer
+    {
+    public:
+        FleetOptimizer(const std::vector<nsgaii::ScheduleParameters>& robots, const FleetOptions& options);
+        // ロボットを持たず，run(problems, warm)で外部の問題だけを最適化する
+        explicit FleetOptimizer(const FleetOptions& options);
+
+        size_t size() const { return robots.size(); }
+        TwoTransProblem& robot(size_t index) { return *robots[index]; }
+        void setMaxGeneration(int max_generation) { options.max_generation = max_generation; }
+
+        // コンストラクタで作ったロボットを初期個体群から最適化する
+        FleetResult run();
+        // 呼び出し元が持つ問題を最適化する（問題はworker_threads = 1で作っておくこと）
+        // warm[r]がtrueの問題は評価済みの親から世代を進める（初期個体群を作らない）
+        FleetResult run(const std::vector<TwoTransProblem*>& problems, const std::vector<bool>& warm);
+        void printSummary(const FleetResult& result, std::ostream& os) const;
+
+    private:
+        // objectiveがtrueなら目的関数を計算し，ステーションを共有する場合は混雑の待ち時間を見積もり直す
+        void evaluateAll(std::vector<nsgaii::Individual> TwoTransProblem::* population, bool objective);
+        void selectReference(size_t robot);
+        void buildTimelines();
+        float congestion(const nsgaii::Individual& individual, size_t robot, int worker);
+
+        FleetOptions options;
+        std::vector<std::unique_ptr<TwoTransProblem>> robots;
+        std::vector<TwoTransProblem*> active; // 現在のrunで最適化している問題
+        nsgaii::WorkStealingPool pool;
+
+        // ステーションの共有（station_capacityが空なら使わない）
+        bool timeline_ready;
+        std::vector<std::vector<StationTimeline::Window>> reference_windows; // ロボットごと
+        std::vector<float> reference_congestion;
+        std::vector<StationTimeline> worker_timelines;                     // ワーカーごとの複製
+        std::vector<int> excluded_robot;                                   // 複製から区間を除いているロボット
+        std::vector<std::vector<StationTimeline::Window>> worker_windows;  // ワーカーごとの作業領域
+    };
+} // namespace charge_schedule
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "nsgaii.hpp"
+
+namespace charge_schedule
+{
+    // 運用者がそのまま配車に使える充電計画（個体から派生値を取り出したもの）
+    struct DecodedSchedule
+    {
+        float f1;                                 // 作業時間 [min]
+        float f2;                                 // SOC高・低領域の滞在時間 [min]
+        int first_soc;
+        int charging_number;
+        std::vector<float> charge_time;           // 充電iのための離脱時刻 [min]
+        std::vector<int> target_soc;              // 充電iの目標SOC [%]
+        std::vector<int> charging_position;       // 充電iの充電位置
+        std::vector<int> return_position;         // 充電iの後の復帰位置
+        std::vector<int> cycle_count;             // 充電iの前の作業サイクル数
+        std::vector<std::array<float, 4>> T_span; // 充電iの作業・移動・充電・復帰の時間 [min]
+    };
+
+    void printSchedule(std::ostream& os, const DecodedSchedule& schedule);
+
+    // 最終的な非支配解アーカイブに対する問い合わせの索引
+    // addで全世代の制約を満たす個体を非支配解だけに絞りながら集め，buildでf1昇順（非支配なのでf2降順）の
+    // 配列と，正規化した目的空間での膝点・理想点距離・下側凸包を前計算する
+    // 問い合わせはbuildの後に呼び，制約付きの問い合わせはO(log n)，膝点・理想点に最も近い解はO(1)
+    class FrontIndex
+    {
+    public:
+        FrontIndex();
+
+        // penalty == 0の個体を追加する（支配される個体は捨て，追加した個体に支配される解は外す）
+        void add(const nsgaii::Individual& individual);
+        void add(const std::vector<nsgaii::Individual>& population);
+        void clear();
+
+        // 問い合わせ用の配列と前計算を作り直す（addの後に呼ぶ）
+        void build();
+
+        std::size_t size() const { return schedules.size(); }
+        bool empty() const { return schedules.empty(); }
+        const std::vector<DecodedSchedule>& front() const { return schedules; } // f1昇順
+
+        // 条件を満たす解が無ければnullptr
+        const DecodedSchedule* minF2WithF1AtMost(float max_f1) const;  // 作業時間がmax_f1以下でf2最小
+        const DecodedSchedule* minF1WithF2AtMost(float max_f2) const;  // f2がmax_f2以下で作業時間最小
+        // 正規化した目的の重み付き和 weight * f1 + (1 - weight) * f2 が最小の解（weightは[0, 1]）
+        const DecodedSchedule* weighted(float weight) const;
+        // 両端の解を結ぶ直線から最も離れた解（正規化した目的空間）
+        const DecodedSchedule* knee() const;
+        // 理想点（各目的の最小値）に最も近い解（正規化した目的空間）
+        const DecodedSchedule* closestToUtopia() const;
+
+    private:
+        float normalizedF1(float f1) const { return (f1 - f1_min) / f1_range; }
+        float normalizedF2(float f2) const { return (f2 - f2_min) / f2_range; }
+
+        std::map<float, DecodedSchedule> archive; // key: f1（addで更新）
+        std::vector<DecodedSchedule> schedules;   // buildで作るf1昇順の配列
+        std::vector<int> hull;                    // 正規化した目的空間の下側凸包（schedulesの添字，f1昇順）
+        std::vector<float> hull_slopes;           // hull[k]からhull[k + 1]への傾き（昇順）
+        int knee_index;
+        int utopia_index;
+        float f1_min;
+        float f1_range;
+        float f2_min;
+        float f2_range;
+    };
+} // namespace charge_schedule
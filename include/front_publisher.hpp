@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "front_shm_layout.hpp"
+#include "nsgaii.hpp"
+
+namespace charge_schedule
+{
+    // 最適化中の第1前線をPOSIX共有メモリ（shm_open）へ公開する
+    // 配置と読み出し側の手順はfront_shm_layout.hpp，読み出しはFrontReaderを使う
+    // 書き込みは1スレッドから行うこと．破棄時に共有メモリの名前を削除する
+    class FrontPublisher
+    {
+    public:
+        // nameはshm_openの名前（"/"で始まる）．capacityを超える前線は先頭から（ソート済みなら良い順に）capacity個
+        FrontPublisher(const std::string& name, uint32_t capacity);
+        ~FrontPublisher();
+        FrontPublisher(const FrontPublisher&) = delete;
+        FrontPublisher& operator=(const FrontPublisher&) = delete;
+
+        // populationのうちfronts_count == 0の個体を公開する（ロックも待ちも行わない）
+        void publish(const std::vector<nsgaii::Individual>& population, uint64_t generation, double hypervolume);
+        // 観測者から呼ぶ版（前線0をビューから直接書き込む）
+        void publish(const nsgaii::GenerationView& view);
+
+        const std::string& name() const { return shm_name; }
+        uint32_t capacity() const { return capacity_; }
+
+    private:
+        void publishRange(const nsgaii::Individual* begin, const nsgaii::Individual* end, uint64_t generation, double hypervolume);
+
+        std::string shm_name;
+        uint32_t capacity_;
+        void* shm_base;
+        size_t shm_size;
+        uint32_t next_slot;
+    };
+} // namespace charge_schedule
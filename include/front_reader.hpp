@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "front_shm_layout.hpp"
+
+namespace charge_schedule
+{
+    struct FrontSnapshot
+    {
+        uint64_t generation;
+        double hypervolume;
+        std::vector<PublishedSchedule> front;
+    };
+
+    // FrontPublisherが公開した第1前線を読み出す（他プロセスから使う．yaml-cppやnsgaiiには依存しない）
+    // 読み出しは書き込み側を待たせず，書き込み途中の面を読んだ場合は読み直す
+    class FrontReader
+    {
+    public:
+        // 共有メモリが無い・形式が違う場合は例外
+        explicit FrontReader(const std::string& name);
+        ~FrontReader();
+        FrontReader(const FrontReader&) = delete;
+        FrontReader& operator=(const FrontReader&) = delete;
+
+        // 最新の前線をsnapshotへコピーする．未公開，またはmax_retries回続けて書き込みと重なった場合はfalse
+        bool read(FrontSnapshot& snapshot, int max_retries = 16) const;
+
+        // 最後に公開された世代（コピーせずに更新の有無を調べる．未公開，または書き込みと重なり続けた場合は-1）
+        int64_t latestGeneration() const;
+
+        uint32_t capacity() const { return capacity_; }
+        uint32_t writerPid() const;
+        uint64_t retries() const { return retry_count; } // 書き込みと重なって読み直した回数の累計
+
+    private:
+        const void* shm_base;
+        size_t shm_size;
+        uint32_t capacity_;
+        mutable uint64_t retry_count;
+    };
+} // namespace charge_schedule
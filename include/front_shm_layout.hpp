@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "genotype_codec.hpp"
+
+namespace charge_schedule
+{
+    // 最新の第1前線を公開する共有メモリの配置（FrontPublisherとFrontReaderで共有）
+    //   FrontShmHeader | FrontShmSlot[0] + PublishedSchedule[capacity] | FrontShmSlot[1] + PublishedSchedule[capacity]
+    // 書き込み側は最後に公開した面と反対の面に書き（seqlock: sequenceを奇数にしてから書き，偶数に戻す），
+    // latestを切り替える．読み出し側はlatestの面をコピーし，前後のsequenceが同じ偶数なら採用する
+    // 読み出し側は書き込み側を待たせず，途中まで書かれた内容は捨てて読み直す
+    constexpr uint32_t kFrontShmMagic = 0x46524f4e; // "FRON"
+    constexpr uint32_t kFrontShmVersion = 1;
+
+    struct PublishedSchedule
+    {
+        float f1;
+        float f2;
+        float charge_time[kCompactMaxCharge]; // 充電開始時刻 time_chromosome [min]（charging_number個）
+        CompactGenotype genotype;             // 充電回数・初期SOC・充電位置・サイクル数・目標SOC
+    };
+
+    struct FrontShmHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t capacity;               // 1面に格納できる個体数
+        uint32_t writer_pid;
+        std::atomic<uint32_t> latest;    // 最後に公開した面（未公開の間は2）
+        uint32_t reserved;
+    };
+
+    struct FrontShmSlot
+    {
+        std::atomic<uint64_t> sequence;  // 奇数の間は書き込み中
+        uint64_t generation;
+        double hypervolume;
+        uint32_t count;                  // 格納している個体数
+        uint32_t reserved;
+    };
+
+    static_assert(std::is_trivially_copyable<PublishedSchedule>::value, "PublishedSchedule must be trivially copyable");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be lock free");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared memory atomics must be lock free");
+
+    inline size_t frontShmAlign(size_t size) { return (size + 63) & ~static_cast<size_t>(63); }
+    inline size_t frontShmSlotStride(uint32_t capacity) {
+        return frontShmAlign(sizeof(FrontShmSlot) + sizeof(PublishedSchedule) * capacity);
+    }
+    inline size_t frontShmSize(uint32_t capacity) {
+        return frontShmAlign(sizeof(FrontShmHeader)) + 2 * frontShmSlotStride(capacity);
+    }
+} // namespace charge_schedule
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nsgaii
+{
+   struct Individual;
+
+   // 世代ごとの結果の読み取り専用ビュー
+   // 同期の観測者には個体群（ソート済みの親）をコピーせずに渡す．ビューは呼び出しの間だけ有効
+   // 非同期の観測者には世代ごとに1回だけ複製した個体群を全員で共有して渡す
+   class GenerationView
+   {
+   public:
+      GenerationView(int generation, double hypervolume, const Individual* population, std::size_t size,
+                     const std::vector<std::vector<int>>& fronts);
+
+      int generation() const { return generation_; }
+      double hypervolume() const { return hypervolume_; }
+
+      std::size_t size() const { return size_; }
+      const Individual& operator[](std::size_t index) const;
+      const Individual* begin() const { return population; }
+      const Individual* end() const;
+
+      // 前線ごとの個体の添字（fronts_countの昇順．前線0がペナルティのない非支配解）
+      std::size_t frontCount() const { return fronts->size(); }
+      const std::vector<int>& front(std::size_t rank) const { return (*fronts)[rank]; }
+
+   private:
+      int generation_;
+      double hypervolume_;
+      const Individual* population;
+      std::size_t size_;
+      const std::vector<std::vector<int>>* fronts;
+   };
+
+   using GenerationObserver = std::function<void(const GenerationView& view)>;
+
+   enum class ObserverDispatch
+   {
+      Synchronous,  // notifyを呼んだスレッドで，notifyの中で呼ぶ
+      Asynchronous  // 専用の配信スレッドで呼ぶ（notifyは複製をキューへ入れて戻る）
+   };
+
+   // 観測者の登録と配信（ScheduleNsgaiiのメンバ）
+   // 複製した問題には観測者を引き継がない（配信スレッドは複製できないため）
+   class ObserverRegistry
+   {
+   public:
+      ObserverRegistry();
+      ~ObserverRegistry();   // 非同期の配信が終わるまで待つ
+      ObserverRegistry(const ObserverRegistry&);
+      ObserverRegistry& operator=(const ObserverRegistry&);
+
+      // 登録した観測者の番号を返す．queue_capacityは非同期配信で溜められる世代数（満杯ならnotifyが待つ）
+      int add(GenerationObserver observer, ObserverDispatch dispatch, std::size_t queue_capacity = 4);
+      void remove(int id);
+      bool empty() const { return entries.empty(); }
+
+      void notify(int generation, double hypervolume, const std::vector<Individual>& population);
+      // 非同期の配信をすべて終えるまで待つ
+      void flush();
+
+   private:
+      struct Entry
+      {
+         int id;
+         GenerationObserver observer;
+         ObserverDispatch dispatch;
+      };
+      class Dispatcher;
+
+      std::vector<Entry> entries;
+      int next_id;
+      std::vector<std::vector<int>> fronts; // 同期配信で使う前線（世代ごとに再利用）
+      std::unique_ptr<Dispatcher> dispatcher;
+      std::size_t queue_capacity;
+   };
+
+   // fronts_countごとに個体の添字をまとめる（frontsは再利用する）
+   void groupFronts(const Individual* population, std::size_t size, std::vector<std::vector<int>>& fronts);
+} // namespace nsgaii
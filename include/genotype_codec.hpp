@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "nsgaii.hpp"
+
+namespace charge_schedule
+{
+    constexpr int kCompactMaxCharge = 64; // 圧縮遺伝子型が保持できる最大充電回数
+    constexpr int kCompactMaxCycle = 127; // 1遺伝子に格納できる最大サイクル数
+
+    // 個体の遺伝子型のみを保持する圧縮形式
+    // 1遺伝子を16bit（[15] 充電位置, [14:8] サイクル数, [7:0] 目標SOC）に詰める
+    // 時刻・充電開始SOC・T_spanなどの派生値と評価値はTwoTransProblem::decodeGenotypeで再計算する
+    struct CompactGenotype
+    {
+        uint8_t charging_number;
+        uint8_t first_soc;
+        uint16_t genes[kCompactMaxCharge];
+    };
+
+    inline uint16_t packGene(int charging_position, int cycle, int soc) {
+        return static_cast<uint16_t>((charging_position << 15) | (cycle << 8) | soc);
+    }
+    inline int geneChargingPosition(uint16_t gene) { return gene >> 15; }
+    inline int geneCycle(uint16_t gene) { return (gene >> 8) & 0x7f; }
+    inline int geneSOC(uint16_t gene) { return gene & 0xff; }
+
+    // 範囲外の遺伝子（充電回数・サイクル数・SOC）を含む場合は例外
+    void encodeGenotype(const nsgaii::Individual& individual, CompactGenotype& genotype);
+    // 実際に使用しているバイト数（ヘッダ + 遺伝子数 × 2）
+    size_t encodedSize(const CompactGenotype& genotype);
+} // namespace charge_schedule
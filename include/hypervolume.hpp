@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace nsgaii
+{
+   // 2目的（ともに最小化）の非支配点集合のハイパーボリュームを差分更新する
+   // 点はf1昇順（非支配なのでf2降順）に保持し，挿入・削除ごとにO(log n)で
+   // 総ハイパーボリュームと各点の排他的寄与量を更新する
+   class HypervolumeTracker
+   {
+   public:
+      HypervolumeTracker(float f1_reference = 0, float f2_reference = 0);
+
+      void setReference(float f1_reference, float f2_reference);
+      void clear();
+
+      // 支配される点・参照点の外側の点は挿入しない（戻り値false）
+      bool insert(float f1, float f2);
+      bool erase(float f1, float f2);
+      bool contains(float f1, float f2) const;
+
+      double contribution(float f1, float f2) const;      // 集合に無い点は0
+      std::pair<float, float> minContributor() const;     // 空の場合は例外
+      std::pair<float, float> popMinContributor();
+
+      double hypervolume() const { return hypervolume_; }
+      std::size_t size() const { return front.size(); }
+      bool empty() const { return front.empty(); }
+      std::vector<std::pair<float, float>> points() const;
+
+   private:
+      struct Entry
+      {
+         float f2;
+         double contribution;
+      };
+      using FrontMap = std::map<float, Entry>;
+
+      double calcContribution(FrontMap::const_iterator it) const;
+      void refreshContribution(FrontMap::iterator it);
+      void eraseAt(FrontMap::iterator it);
+
+      FrontMap front;                                  // key: f1
+      std::set<std::pair<double, float>> by_contribution; // (寄与量, f1)
+      double hypervolume_;
+      float f1_reference;
+      float f2_reference;
+   };
+} // namespace nsgaii
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace nsgaii
+{
+   // 評価値を1つずつ追加しながら支配関係（被支配数と支配している個体の一覧）を更新する
+   // 追加のたびに既存の全点と比較するだけなので，子個体の評価が終わった順に処理でき，
+   // 全個体が揃った時点では前線の取り出し（O(支配関係の数)）だけが残る
+   // 追加順を個体群の添字とすれば，frontsはnonDominatedSortingと同じ結果（同じ並び順）になる
+   class IncrementalDominance
+   {
+   public:
+      void clear();
+      void reserve(std::size_t size);
+
+      // 追加した点の添字を返す
+      std::size_t add(float f1, float f2);
+      std::size_t size() const { return size_; }
+
+      std::vector<std::vector<int>> fronts() const;
+
+   private:
+      std::size_t size_ = 0;
+      std::vector<float> f1_values;
+      std::vector<float> f2_values;
+      std::vector<int> dominated_count;          // 各点を支配している点の数
+      std::vector<std::vector<int>> dominates;   // 各点が支配している点（添字の昇順）
+   };
+} // namespace nsgaii
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "genotype_codec.hpp"
+#include "nsgaii.hpp"
+#include "two_point_trans_schedule.hpp"
+
+namespace charge_schedule
+{
+    // 単一生産者・単一消費者のロックフリーな移住個体の受け渡し箱
+    // 個体は圧縮遺伝子型で受け渡し，受け取った島で復号・評価する
+    class MigrationMailbox
+    {
+    public:
+        MigrationMailbox(size_t capacity);
+
+        bool push(const nsgaii::Individual& individual); // 満杯の場合はfalse（移住個体を破棄）
+        bool pop(CompactGenotype& genotype);             // 空の場合はfalse
+
+    private:
+        std::vector<CompactGenotype> slots;
+        size_t mask;
+        std::atomic<size_t> head; // 消費者が次に読む位置
+        std::atomic<size_t> tail; // 生産者が次に書く位置
+    };
+
+    struct IslandModelOptions
+    {
+        int island_count = 4;             // 島の数
+        int max_generation = 100;         // 最大世代数
+        int migration_interval = 10;      // 移住間隔 [世代]
+        int migration_size = 5;           // 1回の移住個体数
+        unsigned int base_seed = 0;       // 島ごとのシードの基準値
+        bool random_selection = true;     // generateChildrenのrandomフラグ
+        std::vector<float> eta_sbx_values; // 島ごとのSBX分布指数（空の場合はYAMLの値，不足分は循環）
+        std::vector<float> eta_m_values;   // 島ごとの突然変異分布指数
+    };
+
+    struct IslandProgress
+    {
+        int generation;          // 世代数
+        double elapsed_seconds;  // 開始からの経過時間
+        double hypervolume;      // 島のアーカイブのハイパーボリューム
+    };
+
+    // 島ごとに独立したTwoTransProblemを別スレッドで進化させ，一定世代ごとに
+    // リング状に隣の島へフロント0の個体を移住させる
+    class IslandModel
+    {
+    public:
+        IslandModel(const std::string& config_file_path, const IslandModelOptions& options);
+
+        void run();
+        std::vector<nsgaii::Individual> mergedFront();
+        double mergedHypervolume();
+
+        const std::vector<std::vector<IslandProgress>>& progress() const { return progress_; }
+        double elapsedSeconds() const { return elapsed_seconds; }
+
+    private:
+        void runIsland(int island_id);
+        void emigrate(int island_id);
+        void immigrate(int island_id);
+
+        IslandModelOptions options;
+        std::vector<std::unique_ptr<TwoTransProblem>> islands;
+        std::vector<std::unique_ptr<MigrationMailbox>> mailboxes; // mailboxes[i]: 島i-1から島iへ
+        std::vector<std::vector<IslandProgress>> progress_;
+        double elapsed_seconds;
+    };
+} // namespace charge_schedule
@@ -2,37 +2,109 @@
 
 #include <vector>
 #include <array>
+#include <functional>
 #include <memory>
 #include <string>
+#include <random>
+#include <utility>
+
+#include "chromosome_pool.hpp"
+#include "distribution_table.hpp"
+#include "generation_observer.hpp"
+#include "hypervolume.hpp"
+#include "work_stealing_pool.hpp"
 
 namespace nsgaii
 {
    struct Individual
    {
       Individual(const int& chromosome_size);
-      std::vector<float> time_chromosome;
-      std::vector<int> soc_chromosome;
+      ChromosomeVector<float> time_chromosome;
+      ChromosomeVector<int> soc_chromosome;
       float f1;
       float f2;
       int charging_number;
       int penalty;
-      std::vector<std::array<float, 4>> T_span;
-      std::vector<float> T_SOC_HiLow;
-      std::vector<float> E_return;
-      std::vector<float> soc_charging_start;
-      std::vector<int> W;
-      std::vector<int> charging_position;
-      std::vector<int> return_position;
-      std::vector<int> cycle_count;
+      ChromosomeVector<std::array<float, 4>> T_span;
+      ChromosomeVector<float> T_SOC_HiLow;
+      ChromosomeVector<float> E_return;
+      ChromosomeVector<float> soc_charging_start;
+      ChromosomeVector<int> W;
+      ChromosomeVector<int> charging_position;
+      ChromosomeVector<int> return_position;
+      ChromosomeVector<int> cycle_count;
       int fronts_count;
+      float congestion; // f1に含まれる充電ステーションの混雑による待ち時間 [min]（単独の評価では0）
       int first_soc;
       float elapsed_time;
    };
 
+   // 生存選択方式
+   enum class SurvivorSelection
+   {
+      Crowding,    // 混雑距離（NSGA-II）
+      Hypervolume  // ハイパーボリューム寄与量（SMS-EMOA）
+   };
+
+   // 初期個体群の生成方式
+   enum class InitialSampler
+   {
+      Uniform,        // 遺伝子ごとに一様乱数
+      LatinHypercube  // 実行可能領域内のラテン超方格サンプリング（並列生成）
+   };
+
+   // 子個体の生成方式
+   enum class CrossoverMode
+   {
+      PerPair, // 親のペアごと・遺伝子ごとに交叉と突然変異を行う
+      Batch    // 交配プール全体を遺伝子ごとにまとめて交叉・突然変異する
+   };
+
+   // 問題とアルゴリズムのパラメータ（YAMLのcharge_scheduleセクションに対応）
+   // YAMLを介さずに組み立てれば，ロボットごとに異なる問題を1プロセスでまとめて構築できる
+   struct ScheduleParameters
+   {
+      std::vector<float> T_move;    // 移動時間 [min]（訪問先ごと）
+      std::vector<float> T_standby; // 待機時間 [min]
+      std::vector<float> T_cs;      // 充電ステーションまでの移動時間 [min]
+      std::vector<float> E_move;    // 移動中の放電量 [%]
+      std::vector<float> E_standby; // 待機中の放電量 [%]
+      std::vector<float> E_cs;      // 充電ステーションまでの移動中の放電量 [%]
+      int visited_number = 0;
+      int population_size = 0;
+      int T_max = 0;
+      int max_charge_number = 0;
+      int W_target = 0;
+      int SOC_Hi = 0;
+      int SOC_Low = 0;
+      int SOC_cccv = 0;
+      float r_cc = 0;
+      float r_cv = 0;
+      int charging_minimum = 0;
+      float eta_sbx = 0;
+      float eta_m = 0;
+      float mutation_probability = 0;
+      SurvivorSelection survivor_selection = SurvivorSelection::Crowding;
+      InitialSampler initial_sampler = InitialSampler::Uniform;
+      CrossoverMode crossover_mode = CrossoverMode::PerPair;
+      int worker_threads = 1;
+      int initial_threads = 1;      // 初期個体群（latin_hypercube）の並列生成スレッド数（0: ハードウェアのスレッド数）
+      std::pair<float, float> hv_reference = {0, 0}; // YAMLで省略した場合は (T_max, T_max)
+   };
+
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+   // YAMLファイルのcharge_scheduleセクションを読み込む（省略可能な項目は既定値）
+   // 焼き込み版（CHARGE_SCHEDULE_BAKED_PARAMS）ではyaml-cppを使わず，baked_parameters.hppの値を使う
+   ScheduleParameters loadScheduleParameters(const std::string& config_file_path);
+#endif
+
    class ScheduleNsgaii
    {
    public:
-      ScheduleNsgaii(const std::string& config_file_path);
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+      ScheduleNsgaii(const std::string& config_file_path); // loadScheduleParametersに委譲
+#endif
+      explicit ScheduleNsgaii(const ScheduleParameters& parameters);
       virtual ~ScheduleNsgaii() = default;
 
       void generateParents();
@@ -41,9 +113,15 @@ namespace nsgaii
 
       std::vector<std::vector<int>> nonDominatedSorting(std::vector<Individual>& population);
       void crowdingSorting(std::vector<std::vector<int>> fronts, std::vector<Individual>& population);
+      void hypervolumeSorting(std::vector<std::vector<int>> fronts, std::vector<Individual>& population);
       void sortPopulation(std::vector<Individual>& population);
+      // 非支配ソート済みのフロント（populationの添字）を使って並べ替える（sortPopulationの非支配ソート以降）
+      void sortPopulationByFronts(const std::vector<std::vector<int>>& fronts, std::vector<Individual>& population);
       std::pair<Individual, Individual> rankingSelection();
       std::pair<Individual, Individual> randomSelection();
+      // 個体をコピーせずparentsのインデックスを返す選択（charging_numberが小さい方がfirst）
+      std::pair<int, int> rankingSelectionIndex();
+      std::pair<int, int> randomSelectionIndex();
       virtual std::pair<Individual, Individual> crossover(std::pair<Individual, Individual> selected_parents) = 0;
       void mutation();
       bool dominating(Individual& A, Individual& B);
@@ -53,12 +131,78 @@ namespace nsgaii
 
       void setEtaSBX(float eta_sbx);
       void setEtaM(float eta_m);
+      void setMutationProbability(float mutation_probability);
+      void setPopulationSize(int population_size);
+      void setMaxChargeNumber(int max_charge_number);
+      void setSeed(unsigned int seed);
+      float getEtaSBX() const { return eta_sbx; }
+      float getEtaM() const { return eta_m; }
+      float getMutationProbability() const { return mutation_probability; }
+      int getPopulationSize() const { return population_size; }
+      int getMaxChargeNumber() const { return max_charge_number; }
+      void setSurvivorSelection(SurvivorSelection survivor_selection);
+      void setInitialSampler(InitialSampler initial_sampler);
+      void setInitialThreads(int initial_threads); // 0: ハードウェアのスレッド数（既定は1．並列に複数の問題を解く呼び出し側は1のままにする）
+      void setCrossoverMode(CrossoverMode crossover_mode);
+      CrossoverMode getCrossoverMode() const { return crossover_mode; }
+      void setWorkerThreads(int worker_threads); // 子個体生成・評価のスレッド数（0: ハードウェアのスレッド数）
+      int getWorkerThreads() const { return worker_threads; }
+      void setHypervolumeReference(float f1_reference, float f2_reference);
+
+      // リアルタイムモード（機上での再計画用）
+      // 有効にするとpopulation_sizeとmax_charge_numberから世代ループの作業領域と全個体の染色体の容量を確保し，
+      // 以降の世代（generateChildren・evaluatePopulation・generateCombinedPopulation・sortPopulation・generateParents）ではメモリを確保しない
+      // 混雑距離による生存選択とworker_threads = 1が条件（満たさなければ例外）で，子個体は一括交叉で生成する
+      // 初期個体群の生成・部分リスタート・アーカイブのハイパーボリューム・観測者への通知は対象外
+      // 複製した問題には確保した容量が引き継がれないため，複製後に改めて有効にする
+      void setRealtime(bool realtime);
+      bool isRealtime() const { return realtime; }
+
+      // body(index, worker)を[0, count)について実行する
+      // worker_threadsが1ならこのスレッドで順に，それ以外はワーク・スティーリングのプールで実行し，
+      // 各ワーカーにはrandomEngine()から毎回シードし直した専用の乱数エンジンを割り当てる
+      void parallelFor(std::size_t count, const std::function<void(std::size_t, int)>& body);
+      std::vector<WorkStealingPool::WorkerStatistics> workerStatistics() const; // プール未使用なら空
+      void resetWorkerStatistics();
+
+      std::pair<float, float> hypervolumeReference() const;
+      double updateArchiveHypervolume(const std::vector<Individual>& population);
+      double archiveHypervolume() const;
+      void resetArchiveHypervolume();
+
+      // 世代ごとの観測者（ファイル出力・共有メモリ公開・計測など）を登録する．戻り値はremoveObserverに渡す番号
+      // 同期の観測者は呼び出しスレッドでparentsをコピーせずに受け取る．非同期の観測者は配信スレッドで複製を受け取る
+      int addObserver(GenerationObserver observer, ObserverDispatch dispatch = ObserverDispatch::Synchronous);
+      void removeObserver(int id);
+      // ソート済みのparentsを観測者へ渡す（世代ループの最後に呼ぶ）
+      void notifyObservers(int generation, double hypervolume);
+      // parents以外のソート済みの個体群（childrenなど）を観測者へ渡す
+      void notifyObservers(int generation, double hypervolume, const std::vector<Individual>& population);
+      void flushObservers(); // 非同期の観測者への配信が終わるまで待つ
       
       std::vector<Individual> parents;
       std::vector<Individual> children;
       std::vector<Individual> combind_population;
 
+      // スコープの間，呼び出しスレッドが使う乱数エンジンをengineから差し替える
+      // 個体群の並列生成で各スレッドに独立な乱数列を与えるために使う
+      class RandomEngineScope
+      {
+      public:
+         explicit RandomEngineScope(std::mt19937& engine);
+         ~RandomEngineScope();
+         RandomEngineScope(const RandomEngineScope&) = delete;
+         RandomEngineScope& operator=(const RandomEngineScope&) = delete;
+
+      private:
+         std::mt19937* previous;
+      };
+
    protected:
+      std::mt19937& randomEngine(); // RandomEngineScopeが有効ならその乱数エンジン，無ければengine
+      // リアルタイムモードの作業領域を現在のpopulation_size・max_charge_numberで確保する（派生クラスは自分の作業領域を追加する）
+      virtual void reserveRealtime();
+
       std::vector<float> T_move;    // 移動時間 [min]
       std::vector<float> T_standby; // 待機時間 [min]
       std::vector<float> T_cs;      // 充電ステーションまでの移動時間 [min]
@@ -79,5 +223,39 @@ namespace nsgaii
       float eta_sbx;                // SBX分布指数
       float eta_m;                  // 突然変異分布指数
       float mutation_probability;   // 突然変異確率
+      PowerTable sbx_table;         // SBXの広がり係数βのテーブル（eta_sbxの変更時に再構築）
+      PowerTable mutation_table;    // 多項式突然変異のδのテーブル（eta_mの変更時に再構築）
+      SurvivorSelection survivor_selection; // 生存選択方式
+      InitialSampler initial_sampler;       // 初期個体群の生成方式
+      int initial_threads;                  // 初期個体群の並列生成スレッド数（1: 逐次，0: 自動）
+      CrossoverMode crossover_mode;         // 子個体の生成方式
+      int worker_threads;                   // 子個体生成・評価のスレッド数（1: 逐次，0: 自動）
+      WorkStealingPoolHandle worker_pool;   // worker_threadsが1以外のときに使うスレッドプール
+      float f1_reference;           // ハイパーボリューム参照点 f1
+      float f2_reference;           // ハイパーボリューム参照点 f2
+      std::mt19937 engine;          // 乱数エンジン（setSeedで再現可能）
+      HypervolumeTracker archive_tracker; // 全世代の非支配解アーカイブのハイパーボリューム
+      ObserverRegistry observers;         // 世代ごとの観測者（複製した問題には引き継がない）
+      bool realtime;                      // リアルタイムモード（setRealtime）
+
+   private:
+      // リアルタイムモードのソートの作業領域（reserveRealtimeで2 * population_size個体分を確保し，世代をまたいで再利用する）
+      struct SortWorkspace
+      {
+         std::vector<int> dominated;       // 個体iが支配する個体の添字（行iは[i * n, i * n + dominated_count[i])）
+         std::vector<int> dominated_count;
+         std::vector<int> Np;              // 各個体が支配されている数
+         std::vector<int> front_order;     // フロント順（フロント内は混雑距離順）に並べた添字
+         std::vector<int> front_begin;     // フロントkはfront_order[front_begin[k], front_begin[k + 1])
+         std::vector<std::pair<int, float>> indexed_front; // 混雑距離の計算用
+         std::vector<std::pair<int, int>> ranked;          // (penalty, front_orderでの位置)
+         std::vector<char> placed;         // 並べ替えの置換を適用済みの位置
+      };
+
+      // sortPopulationと同じ並べ替えを作業領域だけで行う（混雑距離．結果はsortPopulationと一致する）
+      void sortPopulationRealtime(std::vector<Individual>& population);
+      void reserveIndividual(Individual& individual) const; // 染色体をmax_charge_numberまで伸ばせる容量を確保する
+
+      SortWorkspace sort_workspace;
    };
 } // namespace nsgaii
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "nsgaii.hpp"
+
+namespace nsgaii
+{
+   // 問題クラスをテンプレート引数に取る世代ループ（ヘッダオンリー）
+   // 初期化・評価・子個体生成を仮想関数を介さずProblemの関数として呼び出す
+   // 個体ごとに呼ぶ評価関数（calucObjectiveFunction）は問題クラスのヘッダで定義されていれば評価ループへ展開される
+   // （TwoTransProblemは評価と遺伝子ごとの演算をヘッダで定義している．子個体生成は世代に1回の呼び出しのみ）
+   // ScheduleNsgaiiの仮想関数はこのエンジンを使わない呼び出し側のために残している
+   //
+   // Problemに必要な関数:
+   //   void generateFirstParents();
+   //   void generateChildren(bool random_selection);
+   //   void calucObjectiveFunction(Individual& individual);
+   template <typename Problem>
+   class NsgaiiEngine
+   {
+      static_assert(std::is_base_of<ScheduleNsgaii, Problem>::value, "Problem must derive from ScheduleNsgaii");
+
+   public:
+      explicit NsgaiiEngine(Problem& problem) : problem_(problem) {}
+
+      // 初期個体群を生成・評価・ソートする
+      void initialize() {
+         problem_.Problem::generateFirstParents();
+         evaluate(problem_.parents);
+         problem_.sortPopulation(problem_.parents);
+      }
+
+      void evaluate(std::vector<Individual>& population) {
+         if (problem_.getWorkerThreads() != 1) {
+            problem_.parallelFor(population.size(), [this, &population](std::size_t index, int) {
+               problem_.Problem::calucObjectiveFunction(population[index]);
+            });
+            return;
+         }
+         for (Individual& individual : population) {
+            problem_.Problem::calucObjectiveFunction(individual);
+         }
+      }
+
+      // 1世代進める
+      void step(bool random_selection) {
+         problem_.Problem::generateChildren(random_selection);
+         evaluate(problem_.children);
+         problem_.generateCombinedPopulation();
+         problem_.sortPopulation(problem_.combind_population);
+         problem_.generateParents();
+      }
+
+      void run(int generations, bool random_selection) {
+         for (int generation = 0; generation < generations; ++generation) {
+            step(random_selection);
+         }
+      }
+
+      Problem& problem() { return problem_; }
+      const Problem& problem() const { return problem_; }
+
+   private:
+      Problem& problem_;
+   };
+} // namespace nsgaii
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "front_publisher.hpp"
+#include "nsgaii.hpp"
+
+namespace charge_schedule
+{
+    // ScheduleNsgaii::addObserverに渡す観測者（世代ループを変えずに差し替えられる出力先）
+
+    // 親個体群をCSVへ追記する（base_csv_file_path + "_日時.csv"．書き出しに時間がかかるので非同期での登録を想定）
+    nsgaii::GenerationObserver csvSink(const std::string& base_csv_file_path);
+
+    // 第1前線を共有メモリへ公開する（公開はロックも待ちもしないので同期での登録を想定）
+    nsgaii::GenerationObserver sharedMemorySink(std::shared_ptr<FrontPublisher> publisher);
+
+    // 世代ごとの指標を集める（同期・非同期のどちらで登録してもよい）
+    class MetricsSink
+    {
+    public:
+        struct Record
+        {
+            int generation;
+            std::size_t front_size;   // 前線0の個体数
+            double hypervolume;
+            float min_f1;             // 前線0の最小値（前線0が空なら0）
+            float min_f2;
+            double mean_penalty;      // 個体群の平均ペナルティ
+            double interval_seconds;  // 前の世代の通知からの経過時間（最初の世代は0）
+        };
+
+        MetricsSink();
+
+        // このMetricsSinkを参照する観測者（MetricsSinkは観測者より長く生存させる）
+        nsgaii::GenerationObserver observer();
+
+        std::vector<Record> records() const;
+        void writeCsv(const std::string& csv_file_path) const;
+        void print(std::ostream& os) const;
+
+    private:
+        void record(const nsgaii::GenerationView& view);
+
+        mutable std::mutex mutex;
+        std::vector<Record> records_;
+        double last_time;   // 前の通知の時刻 [s]（未通知なら負）
+    };
+} // namespace charge_schedule
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nsgaii.hpp"
+#include "two_point_trans_schedule.hpp"
+
+namespace charge_schedule
+{
+    // 掃引するパラメータの格子（空の軸はYAMLの値を使用）
+    struct SweepGrid
+    {
+        std::vector<float> eta_sbx;
+        std::vector<float> eta_m;
+        std::vector<float> mutation_probability;
+        std::vector<int> population_size;
+    };
+
+    struct SweepOptions
+    {
+        int repetitions = 1;           // 各セルの繰り返し回数
+        int max_generation = 100;      // 最大世代数
+        int thread_count = 0;          // 同時実行数（0の場合はハードウェアスレッド数）
+        unsigned int base_seed = 0;    // シードの基準値
+        bool random_selection = false; // generateChildrenのrandomフラグ
+    };
+
+    struct SweepCell
+    {
+        float eta_sbx;
+        float eta_m;
+        float mutation_probability;
+        int population_size;
+        int repetition;
+    };
+
+    struct SweepResult
+    {
+        SweepCell cell;
+        double hypervolume;       // 最終世代のアーカイブのハイパーボリューム
+        int generations;          // 実行した世代数
+        long evaluations;         // 評価回数
+        double elapsed_seconds;   // セルの実行時間
+    };
+
+    // パラメータ格子の各セルを共通の初期個体群から並列に実行し，結果を1つの表にまとめる
+    class ParameterSweep
+    {
+    public:
+        ParameterSweep(const std::string& config_file_path, const SweepGrid& grid, const SweepOptions& options);
+
+        const std::vector<SweepCell>& cells() const { return cells_; }
+        const std::vector<SweepResult>& run();
+        void writeResults(const std::string& csv_file_path) const;
+
+    private:
+        SweepResult runCell(size_t cell_index) const;
+
+        std::string config_file_path;
+        SweepOptions options;
+        TwoTransProblem prototype;
+        std::vector<SweepCell> cells_;
+        std::vector<SweepResult> results;
+        // 個体群サイズごとの初期個体群（全セルで共有し変更しない）
+        std::map<int, std::shared_ptr<const std::vector<nsgaii::Individual>>> initial_populations;
+    };
+} // namespace charge_schedule
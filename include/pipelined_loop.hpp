@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.hpp"
+#include "incremental_dominance.hpp"
+#include "two_point_trans_schedule.hpp"
+
+namespace charge_schedule
+{
+    // 世代ループを2段のパイプラインで実行する
+    //   変異段（呼び出しスレッド）: 選択とsecond_crossoverで子を1つずつ作り，容量付きキューへ送る
+    //   評価段（評価スレッド）    : 届いた子から評価し，支配関係の数え上げ（IncrementalDominance）へ追加する
+    //                               親同士の比較は子が届く前に済ませるので，最後の子の後は前線の取り出しだけが残る
+    // 世代ごとの記録は観測者（ScheduleNsgaii::addObserverの非同期配信）で子の生成と並行に行う
+    // 変異段はペアごとの交叉なので，crossover_modeがper_pairでない問題は受け付けない（例外）
+    // 乱数の消費順がgenerateChildren（per_pair・worker_threads = 1）と同じなので，逐次実行と同じ個体群になる
+    class PipelinedLoop
+    {
+    public:
+        struct StageStatistics
+        {
+            std::size_t items;   // 処理した子の数
+            double busy_seconds; // 処理に使った時間
+            double wait_seconds; // キューの空き（変異段）・到着（評価段）を待った時間
+            double occupancy;    // busy_seconds / elapsed_seconds
+        };
+
+        struct Statistics
+        {
+            StageStatistics variation;
+            StageStatistics evaluation;
+            std::size_t queue_capacity;   // 変異段→評価段のキューの容量
+            std::size_t max_queue_depth;
+            double mean_queue_depth;
+            double elapsed_seconds;       // stepの合計時間
+        };
+
+        PipelinedLoop(TwoTransProblem& problem, std::size_t queue_capacity);
+        ~PipelinedLoop();
+        PipelinedLoop(const PipelinedLoop&) = delete;
+        PipelinedLoop& operator=(const PipelinedLoop&) = delete;
+
+        // 1世代進める（generateChildrenからgenerateParentsまでに相当）
+        void step(bool random);
+
+        Statistics statistics();
+        void printStatistics(std::ostream& os);
+
+    private:
+        static constexpr int kBegin = -1; // 世代の開始（評価段が親同士の支配関係を数える）
+        static constexpr int kEnd = -2;   // 世代の終了（評価段が前線を取り出す）
+        static constexpr int kStop = -3;  // スレッドの終了
+
+        struct ChildItem
+        {
+            int index;                   // childrenの添字，またはkBegin・kEnd・kStop
+            nsgaii::Individual individual;
+        };
+
+        void evaluationLoop();
+
+        TwoTransProblem& problem;
+        nsgaii::BoundedQueue<ChildItem> child_queue;
+
+        nsgaii::IncrementalDominance dominance;
+        std::vector<std::vector<int>> fronts;
+
+        std::mutex state_mutex;
+        std::condition_variable state_changed;
+        bool generation_done;
+        std::exception_ptr evaluation_failure;
+
+        // 段ごとの統計（評価段の値はstate_mutexで保護）
+        std::size_t variation_items;
+        double variation_busy_seconds;
+        std::size_t evaluation_items;
+        double evaluation_busy_seconds;
+        double elapsed_seconds;
+
+        std::thread evaluation_thread;
+    };
+} // namespace charge_schedule
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "fixed_individual.hpp"
+#include "genotype_codec.hpp"
+#include "nsgaii.hpp"
+#include "two_point_trans_schedule.hpp"
+
+namespace charge_schedule
+{
+    struct ProcessIslandOptions
+    {
+        int island_count = 4;            // 島（プロセス）の数
+        int max_generation = 100;        // 最大世代数
+        int migration_interval = 10;     // 移住・スナップショット間隔 [世代]
+        int migration_size = 5;          // 1回の移住個体数
+        unsigned int base_seed = 0;      // 島ごとのシードの基準値
+        bool random_selection = true;    // generateChildrenのrandomフラグ
+        double stall_timeout = 30.0;     // 世代が進まない島を停止させるまでの時間 [s]
+        int max_restarts = 3;            // 島ごとの再起動回数の上限
+    };
+
+    // 島ごとに子プロセスを起動し，POSIX共有メモリ上のリングバッファで移住個体を交換する
+    // 異常終了・停止した島は最後の移住時スナップショットから再起動する
+    // 移住個体は圧縮遺伝子型（受け取った島で復号・評価する），スナップショットは評価済みの固定長個体
+    // （FixedIndividual．容量はmax_charge_numberからdispatchFixedCapacityで選ぶ）で格納する
+    class ProcessIslandSupervisor
+    {
+    public:
+        ProcessIslandSupervisor(const std::string& config_file_path, const ProcessIslandOptions& options);
+        ~ProcessIslandSupervisor();
+
+        ProcessIslandSupervisor(const ProcessIslandSupervisor&) = delete;
+        ProcessIslandSupervisor& operator=(const ProcessIslandSupervisor&) = delete;
+
+        void run();
+        std::vector<nsgaii::Individual> mergedFront();
+        double mergedHypervolume();
+        int restartCount() const { return total_restarts; }
+
+    private:
+        struct RingHeader;
+        struct IslandControl;
+
+        void spawnIsland(int island_id);
+        [[noreturn]] void runIsland(int island_id);
+
+        bool pushMigrant(int destination, const nsgaii::Individual& individual);
+        bool popMigrant(int island_id, nsgaii::Individual& individual);
+        void writeSnapshot(int island_id, int generation, const std::vector<nsgaii::Individual>& population);
+        int readSnapshot(int island_id, std::vector<nsgaii::Individual>& population);
+
+        IslandControl* control(int island_id);
+        RingHeader* ring(int island_id);
+        CompactGenotype* ringSlots(int island_id);
+        void* snapshotBuffer(int island_id, int buffer);   // FixedIndividual<容量>の配列
+
+        ProcessIslandOptions options;
+        TwoTransProblem prototype;
+        int population_size;
+        uint32_t ring_capacity;
+        size_t snapshot_individual_bytes; // sizeof(FixedIndividual<容量>)
+
+        std::string shm_name;
+        void* shm_base;
+        size_t shm_size;
+        size_t island_stride;
+
+        std::vector<pid_t> pids;
+        std::vector<int> restarts;
+        int total_restarts;
+    };
+} // namespace charge_schedule
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "nsgaii.hpp"
+
+namespace nsgaii
+{
+   using ObjectivePoint = std::pair<float, float>; // (f1, f2)
+
+   // 個体群から制約を満たす非支配点（重複なし，f1昇順）を取り出す
+   std::vector<ObjectivePoint> nondominatedPoints(const std::vector<Individual>& population);
+   std::vector<ObjectivePoint> nondominatedPoints(std::vector<ObjectivePoint> points);
+
+   double hypervolume(const std::vector<ObjectivePoint>& front, float f1_reference, float f2_reference);
+   // 参照フロントの各点から最も近い解までの距離の平均
+   double invertedGenerationalDistance(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front);
+   // Debの分布指標Δ（0に近いほど一様で端点まで広がっている）
+   double spread(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front);
+
+   struct SummaryStatistics
+   {
+      double median;
+      double lower;   // 中央値の95%信頼区間の下限
+      double upper;   // 中央値の95%信頼区間の上限
+      int count;
+   };
+
+   // 順序統計量による中央値の95%信頼区間（分布を仮定しない）
+   SummaryStatistics summarize(std::vector<double> values);
+} // namespace nsgaii
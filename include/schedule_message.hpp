@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nsgaii
+{
+   struct Individual;
+} // namespace nsgaii
+
+namespace charge_schedule
+{
+    struct DecodedSchedule;
+
+    // ロボットへ配車する充電計画のフラットなバイナリ形式
+    // ScheduleMessageHeader + charge_count × ScheduleCharge（record_bytes間隔）の連続した領域で，
+    // 読み出し側（ScheduleMessageView）は解析もコピーもせずに各値をその場で参照する
+    // 整数・浮動小数点数はホストのバイト順のまま（schedule_protocol.hppと同じく同種のホスト間を想定）
+    // 互換性: 後の版で値を追加する場合はヘッダ・レコードの末尾に足し，header_bytes・record_bytesを増やす
+    //         読み出し側は自分の知っている大きさ以上であれば受け付け，知らない末尾は読み飛ばす
+    namespace schedule_message
+    {
+        constexpr uint32_t kMagic = 0x4d535343; // "CSSM"
+        constexpr uint16_t kVersion = 1;         // 既存の値の意味・位置を変えたときだけ上げる
+        constexpr uint16_t kMaxChargeCount = 1024;
+    } // namespace schedule_message
+
+    struct ScheduleMessageHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t header_bytes;    // このヘッダの大きさ（レコードの開始位置）
+        uint32_t total_bytes;     // メッセージ全体の大きさ
+        uint16_t record_bytes;    // 1充電分のレコードの大きさ
+        uint16_t charge_count;
+        uint32_t robot_id;
+        uint32_t sequence;        // 配車側が付ける計画の通し番号
+        float f1;                 // 作業時間 [min]
+        float f2;                 // SOC高・低領域の滞在時間 [min]
+        uint8_t first_soc;        // 計画開始時のSOC [%]
+        uint8_t reserved[3];
+    };
+
+    struct ScheduleCharge
+    {
+        float departure;          // 充電のための離脱時刻（time_chromosome）[min]
+        float return_time;        // 作業への復帰時刻 [min]（departure + span[1] + span[2] + span[3]）
+        float span[4];            // T_span: 前の復帰からの作業・充電位置への移動・充電・復帰の時間 [min]
+        uint16_t cycle_count;     // 離脱までの作業サイクル数
+        uint8_t target_soc;       // 目標SOC [%]（soc_chromosome）
+        uint8_t charging_position;
+        uint8_t return_position;
+        uint8_t reserved[3];
+    };
+
+    static_assert(sizeof(ScheduleMessageHeader) == 36, "ScheduleMessageHeader layout changed");
+    static_assert(sizeof(ScheduleCharge) == 32, "ScheduleCharge layout changed");
+
+    inline size_t scheduleMessageSize(int charge_count) {
+        return sizeof(ScheduleMessageHeader) + sizeof(ScheduleCharge) * static_cast<size_t>(charge_count);
+    }
+
+    // bufferへ書き込み，書き込んだバイト数を返す（capacityが足りない・値が範囲外なら例外）
+    // bufferは4バイト境界に置くこと．領域の確保は行わない
+    size_t encodeScheduleMessage(const nsgaii::Individual& individual, uint32_t robot_id, uint32_t sequence, void* buffer, size_t capacity);
+    size_t encodeScheduleMessage(const DecodedSchedule& schedule, uint32_t robot_id, uint32_t sequence, void* buffer, size_t capacity);
+    // bufferの大きさをメッセージに合わせてから書き込む
+    void encodeScheduleMessage(const nsgaii::Individual& individual, uint32_t robot_id, uint32_t sequence, std::vector<uint8_t>& buffer);
+    void encodeScheduleMessage(const DecodedSchedule& schedule, uint32_t robot_id, uint32_t sequence, std::vector<uint8_t>& buffer);
+    // 所有する形へ復号する（その場で参照するだけならScheduleMessageViewを使う）．不正な形式ならfalse
+    bool decodeScheduleMessage(const void* data, size_t size, DecodedSchedule& schedule);
+
+    // 受信した領域をその場で参照する読み出し側（領域はビューより長く生存させる）
+    class ScheduleMessageView
+    {
+    public:
+        ScheduleMessageView() : header(nullptr), records(nullptr) {}
+
+        // 形式（magic・版・大きさ・境界）を確かめて参照を張る．不正ならfalseで，ビューは空になる
+        bool reset(const void* data, size_t size) {
+            header = nullptr;
+            records = nullptr;
+            if (data == nullptr || size < sizeof(ScheduleMessageHeader) || reinterpret_cast<uintptr_t>(data) % alignof(ScheduleMessageHeader) != 0) {
+                return false;
+            }
+            const ScheduleMessageHeader* candidate = static_cast<const ScheduleMessageHeader*>(data);
+            if (candidate->magic != schedule_message::kMagic || candidate->version != schedule_message::kVersion
+                || candidate->header_bytes < sizeof(ScheduleMessageHeader) || candidate->header_bytes % alignof(ScheduleCharge) != 0
+                || candidate->record_bytes < sizeof(ScheduleCharge) || candidate->record_bytes % alignof(ScheduleCharge) != 0
+                || candidate->charge_count > schedule_message::kMaxChargeCount || candidate->total_bytes > size
+                || candidate->total_bytes < candidate->header_bytes + static_cast<size_t>(candidate->record_bytes) * candidate->charge_count) {
+                return false;
+            }
+            header = candidate;
+            records = static_cast<const uint8_t*>(data) + candidate->header_bytes;
+            return true;
+        }
+
+        bool valid() const { return header != nullptr; }
+        size_t size() const { return header->total_bytes; }
+
+        uint32_t robotId() const { return header->robot_id; }
+        uint32_t sequence() const { return header->sequence; }
+        float f1() const { return header->f1; }
+        float f2() const { return header->f2; }
+        int firstSoc() const { return header->first_soc; }
+        int chargeCount() const { return header->charge_count; }
+        const ScheduleCharge& charge(int index) const {
+            return *reinterpret_cast<const ScheduleCharge*>(records + static_cast<size_t>(header->record_bytes) * index);
+        }
+
+    private:
+        const ScheduleMessageHeader* header;
+        const uint8_t* records;
+    };
+} // namespace charge_schedule
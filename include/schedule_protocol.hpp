@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "genotype_codec.hpp"
+
+namespace charge_schedule
+{
+    // スケジュール問い合わせサーバ（Unixドメインソケット）のメッセージ形式
+    // 同一ホスト内の通信のみを想定し，整数・浮動小数点数はホストのバイト順のまま送る
+    // フレーム: FrameHeader + payload_bytesバイトのペイロード
+    //   Schedule要求  : ScheduleRequest + float[6 × visited_number]
+    //                   （T_move, T_standby, T_cs, E_move, E_standby, E_cs の順．visited_number = 0ならサーバのYAMLの値．それ以外は2で，値はすべて正の有限値）
+    //   Schedule応答  : ScheduleReply + 前線の個体ごとに float f1, float f2, 圧縮遺伝子型（encodedSizeバイト）
+    //   Statistics要求: ペイロードなし．応答はテキスト（遅延のパーセンタイルなど）
+    namespace protocol
+    {
+        constexpr uint32_t kRequestMagic = 0x51525343; // "CSRQ"
+        constexpr uint32_t kReplyMagic = 0x50525343;   // "CSRP"
+        constexpr uint16_t kVersion = 1;
+        constexpr uint32_t kMaxPayloadBytes = 1 << 20;
+
+        enum class MessageType : uint16_t
+        {
+            Schedule = 1,
+            Statistics = 2
+        };
+
+        enum class ReplyStatus : uint16_t
+        {
+            Ok = 0,
+            InvalidRequest = 1,
+            Failed = 2
+        };
+
+        struct FrameHeader
+        {
+            uint32_t magic;
+            uint16_t version;
+            uint16_t type;          // MessageType
+            uint32_t payload_bytes;
+        };
+
+        struct ScheduleRequest
+        {
+            uint32_t robot_id;
+            uint16_t visited_number;
+            uint16_t generations;   // 0ならサーバの既定値
+            uint8_t first_soc;      // ロボットの現在のSOC [%]
+            uint8_t reserved[3];
+        };
+
+        struct ScheduleReply
+        {
+            uint32_t robot_id;
+            uint16_t status;        // ReplyStatus
+            uint16_t front_size;
+            uint8_t warm;           // 前回の個体群から再開した場合は1
+            uint8_t reserved[3];
+            float server_seconds;   // 受信から応答までの時間
+        };
+
+        // 復号した要求（Schedule要求のペイロード）
+        struct ScheduleRequestData
+        {
+            ScheduleRequest header;
+            std::vector<float> T_move;
+            std::vector<float> T_standby;
+            std::vector<float> T_cs;
+            std::vector<float> E_move;
+            std::vector<float> E_standby;
+            std::vector<float> E_cs;
+        };
+
+        struct FrontEntry
+        {
+            float f1;
+            float f2;
+            CompactGenotype genotype;
+        };
+
+        // ヘッダとペイロードをbufferの末尾に追加する（ノンブロッキングのソケットへ後で送る場合）
+        void appendFrame(std::vector<uint8_t>& buffer, uint32_t magic, MessageType type, const std::vector<uint8_t>& payload);
+        // ヘッダとペイロードを1回の書き込みにまとめて送る（失敗した場合はfalse）
+        bool writeFrame(int fd, uint32_t magic, MessageType type, const std::vector<uint8_t>& payload);
+        // 1フレームを受信するまで待つ（切断・形式の誤りはfalse）
+        bool readFrame(int fd, uint32_t magic, FrameHeader& header, std::vector<uint8_t>& payload);
+        // bufferの先頭に完全なフレームがあれば取り出してtrue（形式の誤りは例外）
+        bool extractFrame(std::vector<uint8_t>& buffer, uint32_t magic, FrameHeader& header, std::vector<uint8_t>& payload);
+
+        void encodeScheduleRequest(const ScheduleRequestData& request, std::vector<uint8_t>& payload);
+        bool decodeScheduleRequest(const std::vector<uint8_t>& payload, ScheduleRequestData& request);
+
+        void encodeScheduleReply(const ScheduleReply& reply, const std::vector<FrontEntry>& front, std::vector<uint8_t>& payload);
+        bool decodeScheduleReply(const std::vector<uint8_t>& payload, ScheduleReply& reply, std::vector<FrontEntry>& front);
+    } // namespace protocol
+} // namespace charge_schedule
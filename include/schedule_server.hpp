@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fleet_optimizer.hpp"
+#include "schedule_protocol.hpp"
+
+namespace charge_schedule
+{
+    struct ServerOptions
+    {
+        std::string socket_path = "/tmp/charge_schedule.sock";
+        int batch_window_ms = 5;          // 最初の要求からこの時間内に届いた要求を1回の最適化にまとめる
+        int max_batch = 64;               // 1回の最適化にまとめる要求の上限
+        int thread_count = 0;             // 共有プールのスレッド数（0の場合はハードウェアスレッド数）
+        int default_generations = 50;     // 要求でgenerations = 0の場合の世代数
+        size_t max_cached_robots = 1024;  // 個体群を保持するロボットの上限（超えたら最も古いものから捨てる）
+        size_t latency_samples = 4096;    // パーセンタイルの計算に使う直近の応答数
+        size_t max_output_bytes = 1 << 24; // クライアントごとに溜める未送信の応答の上限（超えたら切断する）
+    };
+
+    // スケジュール問い合わせサーバ
+    // Unixドメインソケットで要求（ロボットの状態とパラメータ）を受け，batch_window_msの間に届いた要求を
+    // まとめてFleetOptimizerで最適化し，第1前線を圧縮形式で返す（形式はschedule_protocol.hpp）
+    // 1回の最適化には世代数が同じ要求だけをまとめ，世代数の異なる要求は次のまとめに回す
+    // ロボットIDごとに最後の個体群を保持し，次の要求では現在のSOCで復号し直してから世代を進める
+    // （パラメータが変わった場合も遺伝子型を引き継ぐ）
+    // 1つのスレッドでpollによる受信・応答を行い，最適化のみを共有プールで並列に実行する
+    // クライアントのソケットはノンブロッキングにし，応答は接続ごとの送信待ちに積んでPOLLOUTで送る
+    // （読み出しの遅いクライアントが他のクライアントへの応答を止めないように）
+    class ScheduleServer
+    {
+    public:
+        ScheduleServer(const std::string& config_file_path, const ServerOptions& options);
+        ~ScheduleServer();
+        ScheduleServer(const ScheduleServer&) = delete;
+        ScheduleServer& operator=(const ScheduleServer&) = delete;
+
+        // stopが呼ばれるまで要求を処理する
+        void serve();
+        // シグナルハンドラから呼んでもよい
+        void stop() { stopping = true; }
+
+        // Statistics要求への応答と同じ内容
+        std::string statisticsText() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Connection
+        {
+            int fd;
+            std::vector<uint8_t> input;
+            std::vector<uint8_t> output;   // 未送信の応答
+            bool failed;                   // 切断・形式の誤り・送信待ちの超過（pollの周回の最後に閉じる）
+        };
+
+        struct PendingRequest
+        {
+            int fd;
+            protocol::ScheduleRequestData request;
+            Clock::time_point received;
+        };
+
+        struct RobotEntry
+        {
+            std::unique_ptr<TwoTransProblem> problem;
+            nsgaii::ScheduleParameters parameters;
+            uint64_t last_used;
+        };
+
+        void acceptClients();
+        bool readClient(Connection& connection);   // 切断・形式の誤りはfalse
+        bool writeClient(Connection& connection);  // 送れるだけ送る．切断はfalse
+        void handleFrame(int fd, const protocol::FrameHeader& header, const std::vector<uint8_t>& payload);
+        void queueFrame(int fd, protocol::MessageType type, const std::vector<uint8_t>& payload);
+        void runBatch();
+        int requestedGenerations(const PendingRequest& request) const;
+        // 要求のロボットの問題を用意する（評価済みの親を持つ状態にする）．戻り値は前回の個体群を使ったか
+        bool prepareRobot(const protocol::ScheduleRequestData& request, TwoTransProblem*& problem);
+        bool rebase(TwoTransProblem& problem, const std::vector<nsgaii::Individual>& source, int first_soc);
+        void evictRobots();
+        void reply(int fd, const protocol::ScheduleReply& reply, const std::vector<protocol::FrontEntry>& front, Clock::time_point received);
+        void closeConnection(int fd);
+
+        ServerOptions options;
+        nsgaii::ScheduleParameters base_parameters;
+        FleetOptimizer optimizer;
+        int listen_fd;
+        std::atomic<bool> stopping;
+
+        std::vector<Connection> connections;
+        std::vector<PendingRequest> pending;
+        Clock::time_point batch_deadline;
+        std::map<uint32_t, RobotEntry> robots;
+        uint64_t use_counter;
+
+        // 統計
+        std::vector<double> latencies;     // 直近latency_samples件の応答時間 [s]（循環）
+        size_t latency_next;
+        uint64_t requests;
+        uint64_t rejected;
+        uint64_t warm_starts;
+        uint64_t batches;
+        uint64_t batched_requests;         // 最適化した要求の数（平均のまとめ数に使う）
+        double optimise_seconds;
+    };
+} // namespace charge_schedule
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "nsgaii.hpp"
+
+namespace charge_schedule
+{
+    // 充電ステーションごとの占有数の時間軸
+    // 登録する充電区間の端点を座標圧縮し，隣り合う端点の間（基本区間）ごとの占有数を
+    // 区間加算・区間最大のセグメント木で持つ．区間の追加・削除と任意の時間区間の最大占有数の
+    // 問い合わせはそれぞれ O(log n)（nはステーションの区間数）
+    class StationTimeline
+    {
+    public:
+        // 充電のための離脱から復帰までの区間 [begin, end) [min]
+        struct Window
+        {
+            int station;
+            float begin;
+            float end;
+        };
+
+        // 区間の端点を登録して占有数0の時間軸を作る（以降のaddはこの区間のみ指定できる）
+        void build(const std::vector<Window>& windows, int station_count);
+
+        // buildで登録した区間の占有数にdeltaを加える
+        void add(const Window& window, int delta);
+
+        // [begin, end) と重なる基本区間の最大占有数（任意の時刻を指定できる）
+        int maxLoad(int station, float begin, float end) const;
+
+        int stationCount() const { return static_cast<int>(stations.size()); }
+
+        // 個体の各充電の区間をwindowsの末尾に追加する（ステーションは充電位置charging_position）
+        // 充電iの区間は，それまでのT_spanの合計 + T_span[i][0] から T_span[i][1..3] の長さ
+        static void appendWindows(const nsgaii::Individual& individual, std::vector<Window>& windows);
+
+    private:
+        struct Station
+        {
+            std::vector<float> coordinates; // 端点（昇順・重複なし）
+            std::vector<int> max_load;      // 節点の部分木の最大占有数（add_loadを含む）
+            std::vector<int> add_load;      // 節点全体に加えた占有数
+        };
+
+        void add(Station& station, int node, int node_begin, int node_end, int begin, int end, int delta);
+        int maxLoad(const Station& station, int node, int node_begin, int node_end, int begin, int end) const;
+
+        std::vector<Station> stations;
+    };
+} // namespace charge_schedule
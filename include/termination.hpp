@@ -0,0 +1,96 @@
+#pragma once
+
+#include <deque>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nsgaii.hpp"
+
+namespace nsgaii
+{
+   enum class TerminationStatus
+   {
+      Continue,   // 探索を継続
+      Restart,    // 停滞のため非エリート個体を再生成
+      Converged   // 収束したため終了
+   };
+
+   struct TerminationReport
+   {
+      int generations;          // 実行した世代数
+      int max_generation;       // 最大世代数
+      int generations_saved;    // 打ち切りにより削減した世代数
+      long evaluations;         // 実行した評価回数
+      long evaluations_saved;   // 打ち切りにより削減した評価回数
+      int restarts;             // 部分リスタート回数
+      bool converged;           // 収束判定で終了したか
+   };
+
+   // 打ち切り判定のパラメータ（YAMLのterminationセクションに対応．セクションが無ければ打ち切らない）
+   struct TerminationParameters
+   {
+      bool enabled = false;
+      int window = 10;                  // 監視する世代数
+      double hv_tolerance = 1e-3;       // ウィンドウ内のハイパーボリューム相対改善量の閾値
+      double front_stability = 0.9;     // 前世代から変化しなかったフロント0の割合の閾値
+      double diversity_minimum = 0.1;   // 異なる評価値を持つ個体の割合の閾値
+      int max_restarts = 0;             // 部分リスタートの最大回数
+      double restart_elite_ratio = 0.2; // 部分リスタート時に残すエリートの割合
+   };
+
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+   TerminationParameters loadTerminationParameters(const std::string& config_file_path);
+#endif
+
+   // ハイパーボリューム改善量・フロント安定度・個体群多様性をスライディング
+   // ウィンドウで監視し，終了・部分リスタートを判定する
+   class ConvergenceMonitor
+   {
+   public:
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+      ConvergenceMonitor(const std::string& config_file_path, int population_size); // loadTerminationParametersに委譲
+#endif
+      ConvergenceMonitor(const TerminationParameters& parameters, int population_size);
+
+      void reset();
+      TerminationStatus update(const std::vector<Individual>& parents, double hypervolume);
+      void addEvaluations(long evaluations);
+
+      TerminationReport report(int max_generation) const;
+      void printReport(std::ostream& os, int max_generation) const;
+
+      bool enabled() const { return enabled_; }
+      int eliteSize() const;
+
+      double lastHypervolumeImprovement() const { return last_hv_improvement; }
+      double lastFrontStability() const { return last_front_stability; }
+      double lastDiversity() const { return last_diversity; }
+
+   private:
+      double frontStability(const std::vector<std::pair<float, float>>& front) const;
+      static double diversity(const std::vector<Individual>& parents);
+
+      bool enabled_;
+      int window;                   // 監視する世代数
+      double hv_tolerance;          // ウィンドウ内のハイパーボリューム相対改善量の閾値
+      double front_stability;       // 前世代から変化しなかったフロント0の割合の閾値
+      double diversity_minimum;     // 異なる評価値を持つ個体の割合の閾値
+      int max_restarts;             // 部分リスタートの最大回数
+      double restart_elite_ratio;   // 部分リスタート時に残すエリートの割合
+      int population_size;
+
+      int generation;
+      int restarts;
+      long evaluations;
+      bool converged;
+      std::deque<double> hv_history;
+      std::deque<double> stability_history;
+      std::deque<double> diversity_history;
+      std::vector<std::pair<float, float>> last_front;
+      double last_hv_improvement;
+      double last_front_stability;
+      double last_diversity;
+   };
+} // namespace nsgaii
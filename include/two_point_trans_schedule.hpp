@@ -1,59 +1,351 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "genotype_codec.hpp"
 #include "nsgaii.hpp"
+#ifdef CHARGE_SCHEDULE_BAKED_PARAMS
+#include "baked_parameters.hpp"
+#endif
 
 namespace charge_schedule
 {
-    class TwoTransProblem : public nsgaii::ScheduleNsgaii
+    class TwoTransProblem final : public nsgaii::ScheduleNsgaii
     {
     public:
+#ifdef CHARGE_SCHEDULE_BAKED_PARAMS
+        TwoTransProblem(); // 焼き込んだパラメータ（baked::scheduleParameters）で構築する
+#else
         TwoTransProblem(const std::string& config_file_path);
+#endif
+        // 焼き込み版では訪問先ごとのパラメータが焼き込んだ値と一致しなければ例外（T_cycleなどが定数のため）
+        explicit TwoTransProblem(const nsgaii::ScheduleParameters& parameters);
         ~TwoTransProblem() override = default;
 
         nsgaii::Individual generateIndividual(const bool& charging_number_random, const int& fixed_charging_number);
+        // 単位超立方体の点sample（遺伝子ごとに位置・サイクル数・目標SOCの3次元）を
+        // 作業量・SOC・最大作業時間を満たす範囲に写像して個体を作る
+        nsgaii::Individual generateSampledIndividual(const float* sample, int charging_number);
 
         void generateFirstParents() override;
+        int partialRestart(int elite_size);
         void generateChildren(bool random);
         void evaluatePopulation(std::vector<nsgaii::Individual>& population) override;
         std::pair<nsgaii::Individual, nsgaii::Individual> crossover(std::pair<nsgaii::Individual, nsgaii::Individual> selected_parents) override;
         std::pair<nsgaii::Individual, nsgaii::Individual> second_crossover(std::pair<nsgaii::Individual, nsgaii::Individual> selected_parents);
-        std::pair<int, int> int_sbx(int& p1, int& p2, std::pair<int, int>& gene_min, std::pair<int, int>& gene_max);
-        std::pair<float, float> float_sbx(float& p1, float& p2, std::pair<float, float>& gene_min, std::pair<float, float>& gene_max);
+        // second_crossoverを交配プール（parentsのインデックスの組．firstのcharging_numberが小さい方）全体に
+        // 一括で適用し，offspring[2k], offspring[2k + 1]に書き込む
+        // 遺伝子ごとに全ペアの時刻・SOCの範囲，SBX，突然変異を配列（SoA）で計算し，
+        // サイクル数・位置の決定とSOCの伝搬だけをペアごとに逐次処理する
+        void batchCrossover(const std::vector<std::pair<int, int>>& mating_pool, std::vector<nsgaii::Individual>& offspring);
+        std::pair<int, int> int_sbx(int p1, int p2, const std::pair<int, int>& gene_min, const std::pair<int, int>& gene_max);
+        std::pair<float, float> float_sbx(float p1, float p2, const std::pair<float, float>& gene_min, const std::pair<float, float>& gene_max);
 
         float timePolynomialMutation(float gene, float max_gene, float min_gene);
         int socPolynomialMutation(int gene, int max_gene, int min_gene);
 
         void calucObjectiveFunction(nsgaii::Individual& individual);
-        float makespan(std::vector<std::array<float, 4>>& T_span);
-        float soc_HiLowTime(std::vector<float> T_SOC_HiLow);
+        float makespan(const nsgaii::ChromosomeVector<std::array<float, 4>>& T_span);
+        float soc_HiLowTime(const nsgaii::ChromosomeVector<float>& T_SOC_HiLow);
 
         void calcSOCHiLow(nsgaii::Individual& individual);
-        float calcChargingTime(float& soc_start, int& soc_target);
+        float calcChargingTime(float soc_start, int soc_target) const;
 
         void testTwenty();
 
-        int calcCycleMax(nsgaii::Individual& individual, int charging_position, int& last_return_position, int& i);
-        float calcElapsedTime(nsgaii::Individual& individual, int& i);
-        float calcTimeChromosome(int& cycle, int& last_return, int& charging_position, float elapsed_time);
-        float calcSOCchargingStart(float first_soc, int& cycle, int& last_return, int& charging_position);
-        int calcTotalWork(int& cycle, int& last_return, int& charging_position);
-        std::pair<int, int> timeToCycleAndPosition(float& target_time, int& last_return_position, float& elapsed_time);
+        int calcCycleMax(const nsgaii::Individual& individual, int charging_position, int last_return_position, int i) const;
+        float calcElapsedTime(const nsgaii::Individual& individual, int i) const;
+        float calcTimeChromosome(int cycle, int last_return, int charging_position, float elapsed_time) const;
+        float calcSOCchargingStart(float first_soc, int cycle, int last_return, int charging_position) const;
+        int calcTotalWork(int cycle, int last_return, int charging_position) const;
+        std::pair<int, int> timeToCycleAndPosition(float target_time, int last_return_position, float elapsed_time) const;
 
         void fixAndPenalty(nsgaii::Individual& individual);
         void additionalGen(nsgaii::Individual& individual);
         void individualResize(nsgaii::Individual& individual, int new_charging_number);
 
+        // 圧縮遺伝子型から派生値を再計算し，修復・評価まで行う
+        // 復号した計画がSOCの制約内でW_targetに届かない場合（first_socを下げて復号し直した場合など），
+        // 修復（fixAndPenalty → additionalGen）がこの問題の乱数エンジンを使う
+        void decodeGenotype(const CompactGenotype& genotype, nsgaii::Individual& individual);
+
         float calculateHypervolume(const std::vector<nsgaii::Individual>& pareto_front, const float& f1_reference, const float& f2_reference);
         
     private:
+        // parents[begin, size)をinitial_samplerの方式で生成し直す（generateFirstParents・partialRestartで使う）
+        void regenerateParents(int begin);
+        void generateSampledParents(int begin);
+
+        // 一括交叉で1つの遺伝子を処理する子の列（レーン）ごとの値
+        struct GeneLanes
+        {
+            void resize(size_t size);
+
+            std::vector<int> child;           // offspringのインデックス
+            std::vector<int> prev_soc;        // 直前の目標SOC（先頭の遺伝子ではfirst_soc）
+            std::vector<int> last_return;     // 直前の復帰位置
+            std::vector<float> elapsed;       // 直前の遺伝子までの経過時間
+            std::vector<float> own;           // 自分側の親の値
+            std::vector<float> time_min;
+            std::vector<float> time_max;
+            std::vector<int> cycle_max;
+            std::vector<int> cycle_max_position;
+            std::vector<float> value;         // 交叉・突然変異後の時刻
+            std::vector<int> soc_min;
+            std::vector<int> soc;             // 交叉・突然変異後の目標SOC
+        };
+
+        // 一括交叉の作業領域（世代をまたいで再利用する）
+        struct CrossoverWorkspace
+        {
+            std::vector<std::pair<int, int>> mating_pool;
+            std::vector<int> last_return;     // 子ごとの直前の復帰位置
+            std::vector<float> elapsed;       // 子ごとの経過時間
+            std::vector<int> W_total;         // 子ごとの累積タスク量
+            GeneLanes first;                  // ペアの1番目の子（両親の交叉）
+            GeneLanes second;                 // ペアの2番目の子（両親の交叉）
+            GeneLanes tail;                   // 2番目の子の，1番目の子より長い部分（親のコピーと突然変異）
+            std::vector<int> parent_soc_first, parent_soc_second;
+            std::vector<float> uniforms;      // 遺伝子ごとにまとめて引く一様乱数
+            std::vector<float> beta;
+            std::vector<float> delta_first, delta_second;
+        };
+
+        void reserveRealtime() override; // 一括交叉の作業領域もpopulation_size分確保する
+        void batchCrossoverBounds(GeneLanes& lanes, size_t size, bool first_gene);
+        void batchCrossoverPlace(GeneLanes& lanes, size_t size, std::vector<nsgaii::Individual>& offspring, int i);
+        void batchCrossoverClose(const GeneLanes& lanes, size_t size, std::vector<nsgaii::Individual>& offspring, int i);
+
         int min_charge_number;        // 最小充電回数
         int soc_minimum;              // soc最小値
+#ifdef CHARGE_SCHEDULE_BAKED_PARAMS
+        // 焼き込み版ではコンパイル時の定数（使う式ごとに畳み込まれる）
+        static constexpr std::array<float, 4> T_timing = baked::T_timing;
+        static constexpr std::array<float, 4> E_timing = baked::E_timing;
+        static constexpr float T_cycle = baked::T_cycle;  // 1回のタスクにかかる時間
+        static constexpr float E_cycle = baked::E_cycle;  // 1回のタスクの放電量
+#else
         std::vector<float> T_timing;
         std::vector<float> E_timing;
         float T_cycle;  // 1回のタスクにかかる時間
         float E_cycle;  // 1回のタスクの放電量
+#endif
+        CrossoverWorkspace crossover_workspace;
     };
+
+    // 評価と遺伝子ごとの演算（個体ごと・遺伝子ごとに呼ばれる）はヘッダで定義する
+    // TwoTransProblemはfinalなので，NsgaiiEngineなど別の翻訳単位の呼び出し側でもインライン展開できる
+
+    inline void TwoTransProblem::calucObjectiveFunction(nsgaii::Individual& individual)
+    {
+        calcSOCHiLow(individual);
+        individual.f1 = makespan(individual.T_span);
+        individual.congestion = 0;
+        individual.f2 = soc_HiLowTime(individual.T_SOC_HiLow);
+    }
+
+    inline float TwoTransProblem::makespan(const nsgaii::ChromosomeVector<std::array<float, 4>>& T_span)
+    {
+        float makespan = 0;
+        for (const auto& span : T_span) {
+            for (const auto& time : span) {
+                makespan += time;
+            }
+        }
+        if (makespan < 0) { std::cout << "make: エラー" << std::endl;}
+        return makespan;
+    }
+
+    inline float TwoTransProblem::soc_HiLowTime(const nsgaii::ChromosomeVector<float>& T_SOC_HiLow)
+    {
+        float hi_low_time = 0;
+        for (const auto& time : T_SOC_HiLow) {
+            hi_low_time += time;
+        }
+        if (hi_low_time < 0) { std::cout << "soc: エラー" << std::endl;}
+        return hi_low_time;
+    }
+
+    inline void TwoTransProblem::calcSOCHiLow(nsgaii::Individual& individual) {
+        std::array<float, 3> T_socHi = {};
+        std::array<float, 3> T_socLow = {};
+        float last_final_soc = individual.first_soc;
+        for (int i = 0; i < individual.charging_number; ++i) {
+            float first_soc = last_final_soc;
+            // E_return[i]は復帰位置1の待機電力を含む（E_cs[1] + E_standby[1]）
+            float final_soc = individual.soc_chromosome[i] - individual.E_return[i];
+
+            if (SOC_Hi <= individual.soc_charging_start[i]) {
+                T_socHi[0] = individual.T_span[i][0] + individual.T_span[i][1];
+            } else if (individual.soc_charging_start[i] <= SOC_Hi && SOC_Hi <= first_soc) {
+                T_socHi[0] = ((first_soc - SOC_Hi) / (first_soc - individual.soc_charging_start[i])) * (individual.T_span[i][0] + individual.T_span[i][1]);
+            } else {
+                T_socHi[0] = 0;
+            }
+            if (T_socHi[0] < 0) { 
+                std::cout << "first_soc: " << first_soc << std::endl;
+                std::cout << "individual.soc_charging_start[i]: " << individual.soc_charging_start[i] << std::endl;
+                std::cout << "T_socHi[0]: エラー" << std::endl;
+            }
+
+            if (SOC_Hi <= individual.soc_charging_start[i]) {
+                T_socHi[1] = individual.T_span[i][2];
+            } else if (individual.soc_charging_start[i] <= SOC_Hi && SOC_Hi <= individual.soc_chromosome[i]) {
+                T_socHi[1] = (individual.soc_chromosome[i] - SOC_Hi) / r_cv;
+            } else {
+                T_socHi[1] = 0;
+            }
+            if (T_socHi[1] < 0) { std::cout << "T_socHi[1]: エラー" << std::endl;}
+
+            if (SOC_Hi <= final_soc) {
+                T_socHi[2] = individual.T_span[i][3];
+            } else if (final_soc <= SOC_Hi && SOC_Hi <= individual.soc_chromosome[i]) {
+                T_socHi[2] = ((individual.soc_chromosome[i] - SOC_Hi) / (individual.soc_chromosome[i] - final_soc)) * individual.T_span[i][3];
+            } else {
+                T_socHi[2] = 0;
+            }
+            if (T_socHi[2] < 0) { std::cout << "T_socHi[2]: エラー" << std::endl;}
+
+            if (first_soc <= SOC_Low) {
+                T_socLow[0] = individual.T_span[i][0] + individual.T_span[i][1];
+            } else if (individual.soc_charging_start[i] <= SOC_Low && SOC_Low <= first_soc) {
+                T_socLow[0] = ((SOC_Low - individual.soc_charging_start[i]) / (first_soc - individual.soc_charging_start[i])) * (individual.T_span[i][0] + individual.T_span[i][1]);
+            } else {
+                T_socLow[0] = 0;
+            }
+            if (T_socLow[0] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
+
+            if (individual.soc_chromosome[i] <= SOC_Low) {
+                T_socLow[1] = individual.T_span[i][2];
+            } else if (individual.soc_charging_start[i] <= SOC_Low && SOC_Low <= individual.soc_chromosome[i]) {
+                T_socLow[1] = (SOC_Low - individual.soc_charging_start[i]) / r_cc;
+            } else {
+                T_socLow[1] = 0;
+            }
+            if (T_socLow[1] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
+
+            if (individual.soc_chromosome[i] <= SOC_Low) {
+                T_socLow[2] = individual.T_span[i][3];
+            } else if (final_soc <= SOC_Low && SOC_Low <= individual.soc_chromosome[i]) {
+                T_socLow[2] = ((SOC_Low - final_soc) / (individual.soc_chromosome[i] - final_soc)) * individual.T_span[i][3];
+            } else {
+                T_socLow[2] = 0;
+            }
+            if (T_socLow[2] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
+
+            for (int j = 0; j < 3; ++j) {
+                individual.T_SOC_HiLow[i] += T_socHi[j] + T_socLow[j];
+            }
+
+            last_final_soc = final_soc;
+        }
+
+        float first_soc = last_final_soc;
+        float final_soc = first_soc - ((individual.T_span[individual.charging_number][0] / T_cycle) * E_cycle);
+
+        if (SOC_Hi <= final_soc) {
+            T_socHi[0] = individual.T_span[individual.charging_number][0];
+        } else if (final_soc <= SOC_Hi && SOC_Hi <= first_soc) {
+            T_socHi[0] = ((first_soc - SOC_Hi) / (first_soc - final_soc)) * individual.T_span[individual.charging_number][0];
+        } else {
+            T_socHi[0] = 0;
+        }
+        if (first_soc <= SOC_Low) {
+            T_socLow[0] = individual.T_span[individual.charging_number][0];
+        } else if (final_soc <= SOC_Low && SOC_Low <= first_soc) {
+            T_socLow[0] = ((SOC_Low - final_soc) / (first_soc - final_soc)) * individual.T_span[individual.charging_number][0];
+        } else {
+            T_socLow[0] = 0;
+        }
+        if (T_socHi[0] < 0) { 
+            std::cout << "first_soc: " << first_soc << std::endl;
+            std::cout << "individual.soc_charging_start[i]: " << final_soc << std::endl;
+            std::cout << "T_socHi[0]: エラー" << std::endl;
+        }
+        if (T_socLow[0] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
+
+        individual.T_SOC_HiLow[individual.charging_number] += T_socHi[0] + T_socLow[0];
+    }
+
+    inline float TwoTransProblem::calcChargingTime(float soc_charging_start, int soc_target) const
+    {
+        float charging_time = 0;
+
+        if (SOC_cccv <= soc_charging_start){
+            charging_time = (soc_target - soc_charging_start) / r_cv;
+        } else if (soc_charging_start < SOC_cccv && SOC_cccv < soc_target){
+            charging_time = (SOC_cccv - soc_charging_start) / r_cc + (soc_target - SOC_cccv) / r_cv;
+        } else{
+            charging_time = (soc_target - soc_charging_start) / r_cc;
+        }
+
+        return charging_time;
+    }
+
+    inline std::pair<int, int> TwoTransProblem::int_sbx(int p1, int p2, const std::pair<int, int>& gene_min, const std::pair<int, int>& gene_max) {
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
+        std::uniform_real_distribution<> dist(0.0, 1.0);
+
+        float u = dist(gen);
+        float beta = sbx_table.sbxBeta(u);
+
+        int c1 = std::round(0.5 * ((1 + beta) * p1 + (1 - beta) * p2));
+        int c2 = std::round(0.5 * ((1 - beta) * p1 + (1 + beta) * p2));
+
+        // 範囲を制限
+        c1 = std::max(gene_min.first, std::min(c1, gene_max.first));
+        c2 = std::max(gene_min.second, std::min(c2, gene_max.second));
+
+        return std::make_pair(c1, c2);
+    }
+
+    inline std::pair<float, float> TwoTransProblem::float_sbx(float p1, float p2, const std::pair<float, float>& gene_min, const std::pair<float, float>& gene_max) {
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
+        std::uniform_real_distribution<> dist(0.0, 1.0);
+
+        float u = dist(gen);
+        // u = 0.7;
+        float beta = sbx_table.sbxBeta(u);
+
+        float c1 = 0.5 * ((1 + beta) * p1 + (1 - beta) * p2);
+        float c2 = 0.5 * ((1 - beta) * p1 + (1 + beta) * p2);
+
+        // 範囲を制限
+        c1 = std::max(gene_min.first, std::min(c1, gene_max.first));
+        c2 = std::max(gene_min.second, std::min(c2, gene_max.second));
+
+        return std::make_pair(c1, c2);
+    }
+
+    inline float TwoTransProblem::timePolynomialMutation(float gene, float max_gene, float min_gene) {
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+
+        float u = dis(gen);  
+        float delta = mutation_table.mutationDelta(u);
+
+        float mutated_gene = gene + delta * (max_gene - min_gene);
+
+        return std::clamp(mutated_gene, min_gene, max_gene);
+    }
+
+    inline int TwoTransProblem::socPolynomialMutation(int gene, int max_gene, int min_gene) {
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
+        std::uniform_real_distribution<> dis(0.0, 1.0);
+
+        float u = dis(gen);  
+        float delta = mutation_table.mutationDelta(u);
+
+        float mutated_gene_float = gene + delta * (max_gene - min_gene);
+
+        int mutated_gene = static_cast<int>(std::round(mutated_gene_float));
+        return std::clamp(mutated_gene, min_gene, max_gene);
+    }
 } // namespace charge_schedule
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace nsgaii
+{
+   // 添字[0, count)のタスクを実行するワーク・スティーリング方式のスレッドプール
+   // 各ワーカーは自分の区間（両端キュー）の末尾から取り出し，空になると他のワーカーの区間の
+   // 先頭側半分を盗む．子個体の修復（additionalGen）や充電回数の違いでタスクごとの
+   // 実行時間がばらついても，静的分割のようにコアが遊ばない
+   // 呼び出し元のスレッドもワーカー0として働くため，スレッドはthreads - 1本だけ起動する
+   class WorkStealingPool
+   {
+   public:
+      struct WorkerStatistics
+      {
+         std::size_t tasks;   // 実行したタスク数
+         std::size_t steals;  // 盗みに成功した回数
+         double busy_seconds; // タスクの実行に使った時間
+         double utilisation;  // busy_seconds / runの合計時間
+      };
+
+      explicit WorkStealingPool(int threads);
+      ~WorkStealingPool();
+      WorkStealingPool(const WorkStealingPool&) = delete;
+      WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+      int size() const { return static_cast<int>(workers.size()); }
+
+      // ワーカーごとの乱数エンジンをseedから作り直す（ワーカーwはseed_seq{seed, w}）
+      void seed(unsigned int seed);
+      std::mt19937& engine(int worker) { return workers[worker]->engine; }
+
+      // 全タスクについて body(index, worker) を実行し，終わるまで戻らない
+      // bodyが投げた最初の例外は，全タスクの終了後に呼び出し元で再送出する
+      void run(std::size_t count, const std::function<void(std::size_t, int)>& body);
+
+      std::vector<WorkerStatistics> statistics() const; // 生成してから（resetStatisticsから）の累計
+      void resetStatistics();
+
+   private:
+      struct Worker
+      {
+         std::mutex mutex;
+         std::size_t head = 0; // 未実行区間 [head, tail)
+         std::size_t tail = 0;
+         std::mt19937 engine;
+         std::size_t tasks = 0;
+         std::size_t steals = 0;
+         double busy_seconds = 0;
+      };
+
+      void workerLoop(int worker);
+      void work(int worker);
+      bool popOwn(int worker, std::size_t& index);
+      bool steal(int worker);
+
+      std::vector<std::unique_ptr<Worker>> workers;
+      std::vector<std::thread> threads;
+
+      std::mutex job_mutex;
+      std::condition_variable job_ready;
+      std::condition_variable job_done;
+      std::size_t job_generation; // runごとに増やしてワーカーを起こす
+      int running_workers;        // 現在のrunを処理中のワーカー数（呼び出し元を除く）
+      bool stopping;
+
+      const std::function<void(std::size_t, int)>* body;
+      std::atomic<std::size_t> remaining; // 未完了のタスク数
+      std::exception_ptr failure;
+      std::mutex failure_mutex;
+      double run_seconds;
+   };
+
+   // 問題クラスのメンバとしてプールを持つためのハンドル
+   // スレッドは複製できないので，コピー先ではプールを共有せず最初の使用時に作り直す
+   class WorkStealingPoolHandle
+   {
+   public:
+      WorkStealingPoolHandle() = default;
+      WorkStealingPoolHandle(const WorkStealingPoolHandle&) {}
+      WorkStealingPoolHandle& operator=(const WorkStealingPoolHandle&) { pool.reset(); return *this; }
+
+      // threads本のプールを返す（本数が変わったときは作り直す）
+      WorkStealingPool& get(int threads);
+      WorkStealingPool* current() { return pool.get(); }
+      const WorkStealingPool* current() const { return pool.get(); }
+
+   private:
+      std::unique_ptr<WorkStealingPool> pool;
+   };
+} // namespace nsgaii
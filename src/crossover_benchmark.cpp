@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "two_point_trans_schedule.hpp"
+
+// 子個体生成（選択・交叉・突然変異・修復）のスループットを生成方式ごとに測定する
+// per_pair: 親のペアごとにsecond_crossoverを呼ぶ従来の方式
+// batch   : 交配プール全体を遺伝子ごとにまとめて処理するbatchCrossover
+// work_stealing: ペアごとの生成をワーク・スティーリングのプールで並列に実行
+// 最適化の効果を見るため Release ビルド（-DCMAKE_BUILD_TYPE=Release）での実行を想定
+// 使い方: crossover_benchmark [繰り返し回数] [ワーカー数（0: ハードウェアのスレッド数）]
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int repetitions = (argc > 1) ? std::stoi(argv[1]) : 200;
+    int worker_threads = (argc > 2) ? std::stoi(argv[2]) : 0;
+
+    charge_schedule::TwoTransProblem prototype(config_file_path);
+    const std::vector<int> population_sizes = {50, 200, 1000};
+    struct Mode
+    {
+        std::string name;
+        nsgaii::CrossoverMode crossover_mode;
+        int worker_threads;
+    };
+    const std::vector<Mode> modes = {
+        {"per_pair", nsgaii::CrossoverMode::PerPair, 1},
+        {"batch", nsgaii::CrossoverMode::Batch, 1},
+        {"work_stealing", nsgaii::CrossoverMode::PerPair, worker_threads}
+    };
+
+    std::cout << "mode,population_size,repetitions,children_per_second,mean_penalty,workers,mean_utilisation" << std::endl;
+    for (int population_size : population_sizes) {
+        for (const auto& mode : modes) {
+            charge_schedule::TwoTransProblem problem(prototype);
+            problem.setPopulationSize(population_size);
+            problem.setSeed(42);
+            problem.setCrossoverMode(mode.crossover_mode);
+            problem.setWorkerThreads(mode.worker_threads);
+            problem.generateFirstParents();
+            problem.evaluatePopulation(problem.parents);
+            problem.sortPopulation(problem.parents);
+            problem.generateChildren(true); // 作業領域・スレッドの確保を測定から除く
+            problem.resetWorkerStatistics();
+
+            long long penalty = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int repetition = 0; repetition < repetitions; ++repetition) {
+                problem.generateChildren(true);
+                for (const nsgaii::Individual& child : problem.children) {
+                    penalty += child.penalty;
+                }
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double children = static_cast<double>(problem.children.size()) * repetitions;
+
+            // ワーカーごとの稼働率（逐次実行では1ワーカー・稼働率1とみなす）
+            std::vector<nsgaii::WorkStealingPool::WorkerStatistics> workers = problem.workerStatistics();
+            double utilisation = 1.0;
+            if (!workers.empty()) {
+                utilisation = 0;
+                for (const auto& worker : workers) {
+                    utilisation += worker.utilisation;
+                }
+                utilisation /= workers.size();
+            }
+            std::cout << mode.name << "," << population_size << "," << repetitions << ","
+                      << children / seconds << "," << penalty / children << ","
+                      << std::max<size_t>(1, workers.size()) << "," << utilisation << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.hpp"
+
+namespace
+{
+   std::atomic<uint64_t> allocation_count(0);
+   std::atomic<uint64_t> allocation_bytes(0);
+
+   void* countedAllocate(std::size_t size) {
+      allocation_count.fetch_add(1, std::memory_order_relaxed);
+      allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+      void* pointer = std::malloc(size == 0 ? 1 : size);
+      if (pointer == nullptr) {
+         throw std::bad_alloc();
+      }
+      return pointer;
+   }
+} // namespace
+
+namespace nsgaii {
+   uint64_t AllocationCounter::count() {
+      return allocation_count.load(std::memory_order_relaxed);
+   }
+
+   uint64_t AllocationCounter::bytes() {
+      return allocation_bytes.load(std::memory_order_relaxed);
+   }
+} // namespace nsgaii
+
+// グローバルなoperator new/deleteを置き換えて確保回数を数える
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
@@ -0,0 +1,217 @@
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#include "chromosome_pool.hpp"
+
+namespace nsgaii {
+   namespace
+   {
+      constexpr std::size_t kMinBlockShift = 4;   // 最小ブロック 16 B
+      constexpr std::size_t kMaxBlockShift = 12;  // 最大ブロック 4 KiB（これより大きい確保はプールを通さない）
+      constexpr std::size_t kClassCount = kMaxBlockShift - kMinBlockShift + 1;
+      constexpr std::size_t kMaxLocalBlocks = 1024;     // スレッドごと・サイズクラスごとの保持上限
+      constexpr std::size_t kTransferBlocks = 256;      // 共有の予備とまとめてやり取りするブロック数
+      constexpr std::size_t kMaxDepotBlocks = 1 << 16;  // 共有の予備のサイズクラスごとの保持上限
+
+      struct FreeBlock
+      {
+         FreeBlock* next;
+      };
+
+      struct BlockList
+      {
+         FreeBlock* first;
+         FreeBlock* last;
+         std::size_t length;
+      };
+
+      // 別スレッドが解放したブロックを確保するスレッドへ戻すための共有の予備（サイズクラスごと）
+      // ワーカーで確保した子個体を呼び出しスレッドで解放するような偏りがあっても，
+      // 解放側で上限を超えた分をここへ預け，確保側のフリーリストが空になったらここから引き取る
+      struct Depot
+      {
+         std::mutex mutex;
+         FreeBlock* head = nullptr;
+         std::size_t length = 0;
+      };
+      Depot depots[kClassCount];
+
+      std::atomic<uint64_t> total_system_allocations(0);
+
+      // headから最大count個のブロックを切り離す
+      BlockList detach(FreeBlock*& head, std::size_t count) {
+         BlockList list{head, nullptr, 0};
+         while (head != nullptr && list.length < count) {
+            list.last = head;
+            head = head->next;
+            ++list.length;
+         }
+         if (list.last != nullptr) {
+            list.last->next = nullptr;
+         }
+         return list;
+      }
+
+      void deleteBlocks(FreeBlock* head) {
+         while (head != nullptr) {
+            FreeBlock* block = head;
+            head = head->next;
+            ::operator delete(block);
+         }
+      }
+
+      // 共有の予備へ預ける．上限を超える場合はシステムへ返す
+      void deposit(std::size_t c, BlockList list) {
+         if (list.length == 0) {
+            return;
+         }
+         {
+            std::lock_guard<std::mutex> lock(depots[c].mutex);
+            if (depots[c].length + list.length <= kMaxDepotBlocks) {
+               list.last->next = depots[c].head;
+               depots[c].head = list.first;
+               depots[c].length += list.length;
+               return;
+            }
+         }
+         deleteBlocks(list.first);
+      }
+
+      BlockList withdraw(std::size_t c) {
+         std::lock_guard<std::mutex> lock(depots[c].mutex);
+         BlockList list = detach(depots[c].head, kTransferBlocks);
+         depots[c].length -= list.length;
+         return list;
+      }
+
+      struct ThreadPool
+      {
+         std::array<FreeBlock*, kClassCount> heads{};
+         std::array<std::size_t, kClassCount> lengths{};
+         uint64_t system_allocations = 0;
+         uint64_t reused_allocations = 0;
+
+         ~ThreadPool();
+         void release();
+      };
+
+      // スレッド終了時にプールが破棄された後の解放はシステムへ直接返す
+      thread_local bool pool_destroyed = false;
+      thread_local ThreadPool pool;
+
+      ThreadPool::~ThreadPool() {
+         // 終了するスレッドのブロックは他のスレッドが使えるよう共有の予備へ預ける
+         for (std::size_t c = 0; c < kClassCount; ++c) {
+            deposit(c, detach(heads[c], lengths[c]));
+            lengths[c] = 0;
+         }
+         pool_destroyed = true;
+      }
+
+      void ThreadPool::release() {
+         for (std::size_t c = 0; c < kClassCount; ++c) {
+            deleteBlocks(heads[c]);
+            heads[c] = nullptr;
+            lengths[c] = 0;
+         }
+      }
+
+      // 0〜kClassCount-1のサイズクラス．プール対象外はkClassCount
+      std::size_t sizeClass(std::size_t bytes) {
+         std::size_t shift = kMinBlockShift;
+         while ((std::size_t(1) << shift) < bytes) {
+            ++shift;
+            if (shift > kMaxBlockShift) {
+               return kClassCount;
+            }
+         }
+         return shift - kMinBlockShift;
+      }
+   } // namespace
+
+   void* ChromosomePool::allocate(std::size_t bytes) {
+      std::size_t c = sizeClass(bytes);
+      if (c == kClassCount) {
+         return ::operator new(bytes);
+      }
+      // プールの破棄後もサイズクラスの大きさで確保する（別スレッドで解放されるとフリーリストに入るため）
+      const std::size_t block_bytes = std::size_t(1) << (c + kMinBlockShift);
+      if (pool_destroyed) {
+         total_system_allocations.fetch_add(1, std::memory_order_relaxed);
+         return ::operator new(block_bytes);
+      }
+      ThreadPool& local = pool;
+      if (local.heads[c] == nullptr) {
+         BlockList list = withdraw(c);
+         local.heads[c] = list.first;
+         local.lengths[c] = list.length;
+      }
+      if (local.heads[c] != nullptr) {
+         FreeBlock* block = local.heads[c];
+         local.heads[c] = block->next;
+         --local.lengths[c];
+         ++local.reused_allocations;
+         return block;
+      }
+      ++local.system_allocations;
+      total_system_allocations.fetch_add(1, std::memory_order_relaxed);
+      return ::operator new(block_bytes);
+   }
+
+   void ChromosomePool::deallocate(void* pointer, std::size_t bytes) noexcept {
+      if (pointer == nullptr) {
+         return;
+      }
+      std::size_t c = sizeClass(bytes);
+      if (c == kClassCount || pool_destroyed) {
+         ::operator delete(pointer);
+         return;
+      }
+      ThreadPool& local = pool;
+      FreeBlock* block = static_cast<FreeBlock*>(pointer);
+      block->next = local.heads[c];
+      local.heads[c] = block;
+      if (++local.lengths[c] > kMaxLocalBlocks) {
+         BlockList list = detach(local.heads[c], kTransferBlocks);
+         local.lengths[c] -= list.length;
+         deposit(c, list);
+      }
+   }
+
+   ChromosomePool::Statistics ChromosomePool::statistics() {
+      Statistics statistics{0, 0, 0, 0};
+      if (pool_destroyed) {
+         return statistics;
+      }
+      const ThreadPool& local = pool;
+      statistics.system_allocations = local.system_allocations;
+      statistics.reused_allocations = local.reused_allocations;
+      for (std::size_t c = 0; c < kClassCount; ++c) {
+         statistics.cached_blocks += local.lengths[c];
+         statistics.cached_bytes += local.lengths[c] << (c + kMinBlockShift);
+      }
+      return statistics;
+   }
+
+   uint64_t ChromosomePool::totalSystemAllocations() {
+      return total_system_allocations.load(std::memory_order_relaxed);
+   }
+
+   void ChromosomePool::release() {
+      if (!pool_destroyed) {
+         pool.release();
+      }
+      for (std::size_t c = 0; c < kClassCount; ++c) {
+         FreeBlock* head;
+         {
+            std::lock_guard<std::mutex> lock(depots[c].mutex);
+            head = depots[c].head;
+            depots[c].head = nullptr;
+            depots[c].length = 0;
+         }
+         deleteBlocks(head);
+      }
+   }
+} // namespace nsgaii
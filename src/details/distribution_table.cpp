@@ -0,0 +1,48 @@
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include "distribution_table.hpp"
+
+namespace nsgaii {
+   PowerTable::PowerTable(float eta) {
+      build(eta);
+   }
+
+   void PowerTable::build(float eta) {
+      if (!(eta >= 0)) {
+         std::cerr << "分布指数が無効です: " << eta << std::endl;
+         throw std::invalid_argument("distribution index is invalid");
+      }
+      eta_ = eta;
+      exponent = 1.0f / (eta + 1.0f);
+      for (int i = 0; i <= kResolution; ++i) {
+         values[i] = std::pow(static_cast<float>(i) / kResolution, exponent);
+      }
+   }
+
+   float PowerTable::operator()(float x) const {
+      float position = x * kResolution;
+      if (position < kExactCells) {
+         return std::pow(x, exponent);
+      }
+      int index = static_cast<int>(position);
+      if (index >= kResolution) {
+         return values[kResolution];
+      }
+      float fraction = position - index;
+      return values[index] + fraction * (values[index + 1] - values[index]);
+   }
+
+   void PowerTable::sbxBetas(const float* u, float* beta, std::size_t n) const {
+      for (std::size_t i = 0; i < n; ++i) {
+         beta[i] = sbxBeta(u[i]);
+      }
+   }
+
+   void PowerTable::mutationDeltas(const float* u, float* delta, std::size_t n) const {
+      for (std::size_t i = 0; i < n; ++i) {
+         delta[i] = mutationDelta(u[i]);
+      }
+   }
+} // namespace nsgaii
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "fleet_optimizer.hpp"
+
+namespace charge_schedule
+{
+    namespace
+    {
+        int resolveThreadCount(int thread_count) {
+            if (thread_count < 0) {
+                std::cerr << "thread_countが無効です: " << thread_count << std::endl;
+                throw std::invalid_argument("thread_count is invalid");
+            }
+            if (thread_count == 0) {
+                thread_count = std::max(1u, std::thread::hardware_concurrency());
+            }
+            return thread_count;
+        }
+    } // namespace
+
+    FleetOptimizer::FleetOptimizer(const std::vector<nsgaii::ScheduleParameters>& robots, const FleetOptions& options)
+    : FleetOptimizer(options)
+    {
+        if (robots.empty()) {
+            std::cerr << "ロボットのパラメータがありません" << std::endl;
+            throw std::invalid_argument("robots is empty");
+        }
+
+        this->robots.reserve(robots.size());
+        for (size_t r = 0; r < robots.size(); ++r) {
+            // 並列化は共有プールで行うので，ロボットごとの問題は逐次で動かす
+            nsgaii::ScheduleParameters parameters = robots[r];
+            parameters.worker_threads = 1;
+            parameters.initial_threads = 1;
+            this->robots.push_back(std::make_unique<TwoTransProblem>(parameters));
+            this->robots.back()->setSeed(options.base_seed + static_cast<unsigned int>(r));
+        }
+    }
+
+    FleetOptimizer::FleetOptimizer(const FleetOptions& options)
+    : options(options), pool(resolveThreadCount(options.thread_count)), timeline_ready(false)
+    {
+        if (options.evaluation_chunk <= 0) {
+            std::cerr << "evaluation_chunkが無効です: " << options.evaluation_chunk << std::endl;
+            throw std::invalid_argument("evaluation_chunk is invalid");
+        }
+
+        for (int capacity : options.station_capacity) {
+            if (capacity <= 0) {
+                std::cerr << "station_capacityが無効です: " << capacity << std::endl;
+                throw std::invalid_argument("station_capacity is invalid");
+            }
+        }
+        worker_timelines.resize(pool.size());
+        excluded_robot.assign(pool.size(), -1);
+        worker_windows.resize(pool.size());
+    }
+
+    FleetResult FleetOptimizer::run() {
+        std::vector<TwoTransProblem*> problems;
+        for (const auto& robot : robots) {
+            problems.push_back(robot.get());
+        }
+        return run(problems, std::vector<bool>(problems.size(), false));
+    }
+
+    FleetResult FleetOptimizer::run(const std::vector<TwoTransProblem*>& problems, const std::vector<bool>& warm) {
+        if (problems.empty() || warm.size() != problems.size()) {
+            std::cerr << "最適化するロボットが無効です: " << problems.size() << std::endl;
+            throw std::invalid_argument("problems is invalid");
+        }
+        auto start = std::chrono::steady_clock::now();
+        pool.resetStatistics();
+        FleetResult result;
+        result.evaluations = 0;
+
+        active = problems;
+        reference_windows.resize(active.size());
+        reference_congestion.assign(active.size(), 0.0f);
+        timeline_ready = false;
+
+        // 評価済みの親を持つロボット（warm）は初期個体群の生成と評価を省く
+        std::vector<TwoTransProblem*> cold;
+        for (size_t r = 0; r < active.size(); ++r) {
+            if (!warm[r]) {
+                cold.push_back(active[r]);
+            }
+        }
+        active.swap(cold);
+        pool.run(active.size(), [this](std::size_t r, int) {
+            active[r]->setInitialThreads(1); // 呼び出し側が渡した問題もプールのタスク内では逐次に生成する
+            active[r]->generateFirstParents();
+        });
+        evaluateAll(&TwoTransProblem::parents, true);
+        for (const TwoTransProblem* robot : active) {
+            result.evaluations += robot->parents.size();
+        }
+        active.swap(cold);
+
+        pool.run(active.size(), [this](std::size_t r, int) {
+            active[r]->resetArchiveHypervolume();
+            active[r]->sortPopulation(active[r]->parents);
+            active[r]->updateArchiveHypervolume(active[r]->parents);
+            selectReference(r);
+        });
+
+        const bool random = options.random_selection;
+        for (int generation = 0; generation < options.max_generation; ++generation) {
+            pool.run(active.size(), [this, random](std::size_t r, int) {
+                active[r]->generateChildren(random);
+            });
+            if (!options.station_capacity.empty()) {
+                // 前の世代の採用予定のスケジュールで時間軸を作り，親の混雑を見積もり直す
+                buildTimelines();
+                evaluateAll(&TwoTransProblem::parents, false);
+            }
+            evaluateAll(&TwoTransProblem::children, true);
+            pool.run(active.size(), [this](std::size_t r, int) {
+                TwoTransProblem& robot = *active[r];
+                robot.generateCombinedPopulation();
+                robot.sortPopulation(robot.combind_population);
+                robot.generateParents();
+                robot.updateArchiveHypervolume(robot.children);
+                selectReference(r);
+            });
+            for (const TwoTransProblem* robot : active) {
+                result.evaluations += robot->children.size();
+            }
+        }
+
+        result.generations = options.max_generation;
+        result.robots.resize(active.size());
+        for (size_t r = 0; r < active.size(); ++r) {
+            for (const nsgaii::Individual& individual : active[r]->parents) {
+                if (individual.fronts_count == 0) {
+                    result.robots[r].front.push_back(individual);
+                }
+            }
+            result.robots[r].hypervolume = active[r]->archiveHypervolume();
+            result.robots[r].congestion = reference_congestion[r];
+        }
+        result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.workers = pool.statistics();
+        return result;
+    }
+
+    void FleetOptimizer::evaluateAll(std::vector<nsgaii::Individual> TwoTransProblem::* population, bool objective) {
+        const bool shared_stations = timeline_ready && !options.station_capacity.empty();
+        if (!objective && !shared_stations) {
+            return;
+        }
+
+        // 全ロボットの個体を通し番号で並べ，evaluation_chunk個ずつを1タスクにする
+        std::vector<size_t> offsets(active.size() + 1, 0);
+        for (size_t r = 0; r < active.size(); ++r) {
+            offsets[r + 1] = offsets[r] + ((*active[r]).*population).size();
+        }
+        const size_t total = offsets.back();
+        const size_t chunk = options.evaluation_chunk;
+        pool.run((total + chunk - 1) / chunk, [&](std::size_t task, int worker) {
+            size_t begin = task * chunk;
+            size_t end = std::min(begin + chunk, total);
+            size_t r = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+            for (size_t index = begin; index < end; ++index) {
+                while (index >= offsets[r + 1]) {
+                    ++r;
+                }
+                TwoTransProblem& robot = *active[r];
+                nsgaii::Individual& individual = (robot.*population)[index - offsets[r]];
+                if (objective) {
+                    robot.calucObjectiveFunction(individual);
+                }
+                if (shared_stations) {
+                    individual.f1 -= individual.congestion;
+                    individual.congestion = congestion(individual, r, worker);
+                    individual.f1 += individual.congestion;
+                }
+            }
+        });
+    }
+
+    void FleetOptimizer::selectReference(size_t r) {
+        if (options.station_capacity.empty()) {
+            return;
+        }
+        const std::vector<nsgaii::Individual>& parents = active[r]->parents;
+        const nsgaii::Individual* reference = nullptr;
+        for (const nsgaii::Individual& individual : parents) {
+            if (individual.fronts_count != 0) continue;
+            if (reference == nullptr || individual.f1 + individual.f2 < reference->f1 + reference->f2) {
+                reference = &individual;
+            }
+        }
+        if (reference == nullptr) {
+            // ペナルティのない個体が無い場合は先頭（最も良い前線）の個体を使う
+            reference = &parents.front();
+        }
+        reference_windows[r].clear();
+        StationTimeline::appendWindows(*reference, reference_windows[r]);
+        // 容量の範囲外の充電位置は制約の対象外とする
+        const int station_count = static_cast<int>(options.station_capacity.size());
+        reference_windows[r].erase(std::remove_if(reference_windows[r].begin(), reference_windows[r].end(),
+            [station_count](const StationTimeline::Window& window) { return window.station < 0 || window.station >= station_count; }),
+            reference_windows[r].end());
+        reference_congestion[r] = reference->congestion;
+    }
+
+    void FleetOptimizer::buildTimelines() {
+        std::vector<StationTimeline::Window> windows;
+        for (const auto& robot_windows : reference_windows) {
+            windows.insert(windows.end(), robot_windows.begin(), robot_windows.end());
+        }
+        StationTimeline& timeline = worker_timelines.front();
+        timeline.build(windows, static_cast<int>(options.station_capacity.size()));
+        for (const StationTimeline::Window& window : windows) {
+            timeline.add(window, 1);
+        }
+        // ワーカーごとの複製は，評価するロボット自身の区間を除いて使う
+        for (size_t w = 1; w < worker_timelines.size(); ++w) {
+            worker_timelines[w] = timeline;
+        }
+        excluded_robot.assign(worker_timelines.size(), -1);
+        timeline_ready = true;
+    }
+
+    float FleetOptimizer::congestion(const nsgaii::Individual& individual, size_t r, int worker) {
+        StationTimeline& timeline = worker_timelines[worker];
+        if (excluded_robot[worker] != static_cast<int>(r)) {
+            if (excluded_robot[worker] >= 0) {
+                for (const StationTimeline::Window& window : reference_windows[excluded_robot[worker]]) {
+                    timeline.add(window, 1);
+                }
+            }
+            for (const StationTimeline::Window& window : reference_windows[r]) {
+                timeline.add(window, -1);
+            }
+            excluded_robot[worker] = static_cast<int>(r);
+        }
+
+        std::vector<StationTimeline::Window>& windows = worker_windows[worker];
+        windows.clear();
+        StationTimeline::appendWindows(individual, windows);
+        float wait = 0;
+        for (const StationTimeline::Window& window : windows) {
+            if (window.station < 0 || window.station >= timeline.stationCount()) continue;
+            const int capacity = options.station_capacity[window.station];
+            const int excess = timeline.maxLoad(window.station, window.begin, window.end) + 1 - capacity;
+            if (excess > 0) {
+                wait += excess * (window.end - window.begin) / capacity;
+            }
+        }
+        return options.congestion_weight * wait;
+    }
+
+    void FleetOptimizer::printSummary(const FleetResult& result, std::ostream& os) const {
+        os << "--- fleet ---" << std::endl;
+        os << "  robots: " << result.robots.size() << ", generations: " << result.generations
+           << ", evaluations: " << result.evaluations << ", elapsed: " << result.elapsed_seconds << " s" << std::endl;
+        for (size_t r = 0; r < result.robots.size(); ++r) {
+            os << "  robot " << r << ": front " << result.robots[r].front.size()
+               << ", hyper_volume " << result.robots[r].hypervolume
+               << ", congestion " << result.robots[r].congestion << std::endl;
+        }
+        for (size_t w = 0; w < result.workers.size(); ++w) {
+            const auto& worker = result.workers[w];
+            os << "  worker " << w << ": tasks " << worker.tasks << ", steals " << worker.steals
+               << ", utilisation " << worker.utilisation << std::endl;
+        }
+    }
+} // namespace charge_schedule
@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "front_index.hpp"
+
+namespace charge_schedule
+{
+    namespace
+    {
+        DecodedSchedule decodeSchedule(const nsgaii::Individual& individual) {
+            DecodedSchedule schedule;
+            const int n = individual.charging_number;
+            schedule.f1 = individual.f1;
+            schedule.f2 = individual.f2;
+            schedule.first_soc = individual.first_soc;
+            schedule.charging_number = n;
+            schedule.charge_time.assign(individual.time_chromosome.begin(), individual.time_chromosome.begin() + n);
+            schedule.target_soc.assign(individual.soc_chromosome.begin(), individual.soc_chromosome.begin() + n);
+            schedule.charging_position.assign(individual.charging_position.begin(), individual.charging_position.begin() + n);
+            schedule.return_position.assign(individual.return_position.begin(), individual.return_position.begin() + n);
+            schedule.cycle_count.assign(individual.cycle_count.begin(), individual.cycle_count.begin() + n);
+            schedule.T_span.assign(individual.T_span.begin(), individual.T_span.begin() + n);
+            return schedule;
+        }
+    } // namespace
+
+    FrontIndex::FrontIndex()
+    : knee_index(-1), utopia_index(-1), f1_min(0), f1_range(1), f2_min(0), f2_range(1)
+    {
+    }
+
+    void FrontIndex::add(const nsgaii::Individual& individual) {
+        if (individual.penalty != 0) {
+            return;
+        }
+        // f1がindividual以下の解のうちf2最小のもの（f1昇順・f2降順なので直前の解）に支配されるなら捨てる
+        auto it = archive.upper_bound(individual.f1);
+        if (it != archive.begin() && std::prev(it)->second.f2 <= individual.f2) {
+            return;
+        }
+        // 追加する解に支配される解（f1以上でf2以上）はf1の直後に連続して並ぶ
+        it = archive.lower_bound(individual.f1);
+        while (it != archive.end() && it->second.f2 >= individual.f2) {
+            it = archive.erase(it);
+        }
+        archive.emplace_hint(it, individual.f1, decodeSchedule(individual));
+    }
+
+    void FrontIndex::add(const std::vector<nsgaii::Individual>& population) {
+        for (const nsgaii::Individual& individual : population) {
+            add(individual);
+        }
+    }
+
+    void FrontIndex::clear() {
+        archive.clear();
+        schedules.clear();
+        hull.clear();
+        hull_slopes.clear();
+        knee_index = -1;
+        utopia_index = -1;
+    }
+
+    void FrontIndex::build() {
+        schedules.clear();
+        schedules.reserve(archive.size());
+        for (const auto& entry : archive) {
+            schedules.push_back(entry.second);
+        }
+        hull.clear();
+        hull_slopes.clear();
+        knee_index = -1;
+        utopia_index = -1;
+        if (schedules.empty()) {
+            return;
+        }
+
+        // 両端の解で正規化する（f1最小の解がf2最大，f1最大の解がf2最小）
+        f1_min = schedules.front().f1;
+        f2_min = schedules.back().f2;
+        f1_range = schedules.back().f1 - f1_min;
+        f2_range = schedules.front().f2 - f2_min;
+        if (f1_range <= 0) f1_range = 1;
+        if (f2_range <= 0) f2_range = 1;
+
+        // 膝点: 両端を結ぶ直線 x + y = 1 から最も離れた解（1 - x - yが最大）
+        // 理想点距離: 正規化した目的空間での原点からの距離が最小の解
+        float best_knee = -std::numeric_limits<float>::infinity();
+        float best_utopia = std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < schedules.size(); ++i) {
+            const float x = normalizedF1(schedules[i].f1);
+            const float y = normalizedF2(schedules[i].f2);
+            if (1 - x - y > best_knee) {
+                best_knee = 1 - x - y;
+                knee_index = static_cast<int>(i);
+            }
+            if (x * x + y * y < best_utopia) {
+                best_utopia = x * x + y * y;
+                utopia_index = static_cast<int>(i);
+            }
+        }
+
+        // 下側凸包（Andrewのモノトーンチェーン）．重み付き和の最小解は凸包の頂点にある
+        for (size_t i = 0; i < schedules.size(); ++i) {
+            const float x = normalizedF1(schedules[i].f1);
+            const float y = normalizedF2(schedules[i].f2);
+            while (hull.size() >= 2) {
+                const float ax = normalizedF1(schedules[hull[hull.size() - 2]].f1);
+                const float ay = normalizedF2(schedules[hull[hull.size() - 2]].f2);
+                const float bx = normalizedF1(schedules[hull.back()].f1);
+                const float by = normalizedF2(schedules[hull.back()].f2);
+                // a→b→(x, y) が左回りでなければbは凸包の頂点ではない
+                if ((bx - ax) * (y - ay) - (by - ay) * (x - ax) > 0) break;
+                hull.pop_back();
+            }
+            hull.push_back(static_cast<int>(i));
+        }
+        for (size_t k = 0; k + 1 < hull.size(); ++k) {
+            const DecodedSchedule& a = schedules[hull[k]];
+            const DecodedSchedule& b = schedules[hull[k + 1]];
+            hull_slopes.push_back((normalizedF2(b.f2) - normalizedF2(a.f2)) / (normalizedF1(b.f1) - normalizedF1(a.f1)));
+        }
+    }
+
+    const DecodedSchedule* FrontIndex::minF2WithF1AtMost(float max_f1) const {
+        // f1 <= max_f1の最後の解（f2降順なのでf2最小）
+        auto it = std::upper_bound(schedules.begin(), schedules.end(), max_f1,
+                                   [](float value, const DecodedSchedule& schedule) { return value < schedule.f1; });
+        if (it == schedules.begin()) {
+            return nullptr;
+        }
+        return &*std::prev(it);
+    }
+
+    const DecodedSchedule* FrontIndex::minF1WithF2AtMost(float max_f2) const {
+        // f2 <= max_f2の最初の解（f1昇順なのでf1最小）
+        auto it = std::partition_point(schedules.begin(), schedules.end(),
+                                       [max_f2](const DecodedSchedule& schedule) { return schedule.f2 > max_f2; });
+        if (it == schedules.end()) {
+            return nullptr;
+        }
+        return &*it;
+    }
+
+    const DecodedSchedule* FrontIndex::weighted(float weight) const {
+        if (weight < 0 || weight > 1) {
+            std::cerr << "weightが無効です: " << weight << std::endl;
+            throw std::invalid_argument("weight is invalid");
+        }
+        if (hull.empty()) {
+            return nullptr;
+        }
+        // weight * x + (1 - weight) * y は，傾きが -weight / (1 - weight) 以上になる最初の凸包の頂点で最小
+        const float threshold = (weight == 1) ? -std::numeric_limits<float>::infinity() : -weight / (1 - weight);
+        const size_t k = std::lower_bound(hull_slopes.begin(), hull_slopes.end(), threshold) - hull_slopes.begin();
+        return &schedules[hull[k]];
+    }
+
+    const DecodedSchedule* FrontIndex::knee() const {
+        return (knee_index < 0) ? nullptr : &schedules[knee_index];
+    }
+
+    const DecodedSchedule* FrontIndex::closestToUtopia() const {
+        return (utopia_index < 0) ? nullptr : &schedules[utopia_index];
+    }
+
+    void printSchedule(std::ostream& os, const DecodedSchedule& schedule) {
+        os << "f1: " << schedule.f1 << ", f2: " << schedule.f2 << ", first_soc: " << schedule.first_soc
+           << ", charging_number: " << schedule.charging_number << std::endl;
+        for (int i = 0; i < schedule.charging_number; ++i) {
+            os << "  " << i << ". time " << schedule.charge_time[i] << ", soc " << schedule.target_soc[i]
+               << ", charging_position " << schedule.charging_position[i] << ", return_position " << schedule.return_position[i]
+               << ", cycle " << schedule.cycle_count[i] << std::endl;
+        }
+    }
+} // namespace charge_schedule
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "front_publisher.hpp"
+
+namespace charge_schedule
+{
+    FrontPublisher::FrontPublisher(const std::string& name, uint32_t capacity)
+    : shm_name(name), capacity_(capacity), shm_base(nullptr), shm_size(frontShmSize(capacity)), next_slot(0)
+    {
+        if (name.size() < 2 || name[0] != '/' || name.find('/', 1) != std::string::npos) {
+            std::cerr << "共有メモリの名前が無効です: " << name << std::endl;
+            throw std::invalid_argument("shared memory name is invalid");
+        }
+        if (capacity == 0) {
+            std::cerr << "capacityが無効です: " << capacity << std::endl;
+            throw std::invalid_argument("capacity is invalid");
+        }
+
+        // 前回の実行で残った領域は読み出し側ごと切り離し，新しく作り直す
+        shm_unlink(shm_name.c_str());
+        int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            std::cerr << "共有メモリを作成できませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("shm_open failed");
+        }
+        if (ftruncate(fd, shm_size) != 0) {
+            close(fd);
+            shm_unlink(shm_name.c_str());
+            std::cerr << "共有メモリのサイズを設定できませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("ftruncate failed");
+        }
+        shm_base = mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (shm_base == MAP_FAILED) {
+            shm_base = nullptr;
+            shm_unlink(shm_name.c_str());
+            std::cerr << "共有メモリをマップできませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("mmap failed");
+        }
+
+        char* base = static_cast<char*>(shm_base);
+        for (int s = 0; s < 2; ++s) {
+            FrontShmSlot* slot = new (base + frontShmAlign(sizeof(FrontShmHeader)) + s * frontShmSlotStride(capacity)) FrontShmSlot;
+            slot->sequence.store(0, std::memory_order_relaxed);
+            slot->generation = 0;
+            slot->hypervolume = 0;
+            slot->count = 0;
+        }
+        FrontShmHeader* header = new (base) FrontShmHeader;
+        header->capacity = capacity;
+        header->writer_pid = static_cast<uint32_t>(getpid());
+        header->latest.store(2, std::memory_order_relaxed);
+        header->version = kFrontShmVersion;
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = kFrontShmMagic; // 読み出し側はmagicを見てから他の値を使う
+    }
+
+    FrontPublisher::~FrontPublisher() {
+        if (shm_base != nullptr) {
+            munmap(shm_base, shm_size);
+            shm_unlink(shm_name.c_str());
+        }
+    }
+
+    void FrontPublisher::publish(const std::vector<nsgaii::Individual>& population, uint64_t generation, double hypervolume) {
+        publishRange(population.data(), population.data() + population.size(), generation, hypervolume);
+    }
+
+    void FrontPublisher::publish(const nsgaii::GenerationView& view) {
+        publishRange(view.begin(), view.end(), static_cast<uint64_t>(view.generation()), view.hypervolume());
+    }
+
+    void FrontPublisher::publishRange(const nsgaii::Individual* begin, const nsgaii::Individual* end, uint64_t generation, double hypervolume) {
+        char* base = static_cast<char*>(shm_base);
+        FrontShmHeader* header = reinterpret_cast<FrontShmHeader*>(base);
+        FrontShmSlot* slot = reinterpret_cast<FrontShmSlot*>(base + frontShmAlign(sizeof(FrontShmHeader)) + next_slot * frontShmSlotStride(capacity_));
+        PublishedSchedule* entries = reinterpret_cast<PublishedSchedule*>(slot + 1);
+
+        // seqlock: 奇数にしてから書き，偶数に戻す（読み出し側は前後で値が変わっていれば捨てる）
+        const uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint32_t count = 0;
+        for (const nsgaii::Individual* it = begin; it != end; ++it) {
+            const nsgaii::Individual& individual = *it;
+            if (count == capacity_) break;
+            if (individual.fronts_count != 0) continue;
+            PublishedSchedule& entry = entries[count];
+            try {
+                encodeGenotype(individual, entry.genotype);
+            } catch (const std::out_of_range&) {
+                continue;
+            }
+            entry.f1 = individual.f1;
+            entry.f2 = individual.f2;
+            std::copy(individual.time_chromosome.begin(), individual.time_chromosome.begin() + individual.charging_number, entry.charge_time);
+            ++count;
+        }
+        slot->generation = generation;
+        slot->hypervolume = hypervolume;
+        slot->count = count;
+
+        slot->sequence.store(sequence + 2, std::memory_order_release);
+        header->latest.store(next_slot, std::memory_order_release);
+        next_slot ^= 1;
+    }
+} // namespace charge_schedule
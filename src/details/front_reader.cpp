@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "front_reader.hpp"
+
+namespace charge_schedule
+{
+    FrontReader::FrontReader(const std::string& name)
+    : shm_base(nullptr), shm_size(0), capacity_(0), retry_count(0)
+    {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            std::cerr << "共有メモリを開けませんでした: " << name << ": " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("shm_open failed");
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(FrontShmHeader)) {
+            close(fd);
+            std::cerr << "共有メモリの大きさが無効です: " << name << std::endl;
+            throw std::runtime_error("shared memory size is invalid");
+        }
+        shm_size = status.st_size;
+        void* base = mmap(nullptr, shm_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            std::cerr << "共有メモリをマップできませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("mmap failed");
+        }
+        shm_base = base;
+
+        const FrontShmHeader* header = static_cast<const FrontShmHeader*>(shm_base);
+        const bool valid = header->magic == kFrontShmMagic;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!valid || header->version != kFrontShmVersion || shm_size < frontShmSize(header->capacity)) {
+            munmap(const_cast<void*>(shm_base), shm_size);
+            std::cerr << "共有メモリの形式が無効です: " << name << std::endl;
+            throw std::runtime_error("shared memory layout is invalid");
+        }
+        capacity_ = header->capacity;
+    }
+
+    FrontReader::~FrontReader() {
+        munmap(const_cast<void*>(shm_base), shm_size);
+    }
+
+    bool FrontReader::read(FrontSnapshot& snapshot, int max_retries) const {
+        const char* base = static_cast<const char*>(shm_base);
+        const FrontShmHeader* header = reinterpret_cast<const FrontShmHeader*>(base);
+        for (int attempt = 0; attempt <= max_retries; ++attempt) {
+            const uint32_t latest = header->latest.load(std::memory_order_acquire);
+            if (latest > 1) {
+                return false;
+            }
+            const FrontShmSlot* slot = reinterpret_cast<const FrontShmSlot*>(base + frontShmAlign(sizeof(FrontShmHeader)) + latest * frontShmSlotStride(capacity_));
+            const PublishedSchedule* entries = reinterpret_cast<const PublishedSchedule*>(slot + 1);
+
+            const uint64_t before = slot->sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                const uint32_t count = std::min(slot->count, capacity_);
+                snapshot.generation = slot->generation;
+                snapshot.hypervolume = slot->hypervolume;
+                snapshot.front.resize(count);
+                std::memcpy(snapshot.front.data(), entries, sizeof(PublishedSchedule) * count);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot->sequence.load(std::memory_order_relaxed) == before) {
+                    return true;
+                }
+            }
+            ++retry_count;
+        }
+        return false;
+    }
+
+    int64_t FrontReader::latestGeneration() const {
+        const char* base = static_cast<const char*>(shm_base);
+        const FrontShmHeader* header = reinterpret_cast<const FrontShmHeader*>(base);
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            const uint32_t latest = header->latest.load(std::memory_order_acquire);
+            if (latest > 1) {
+                return -1;
+            }
+            const FrontShmSlot* slot = reinterpret_cast<const FrontShmSlot*>(base + frontShmAlign(sizeof(FrontShmHeader)) + latest * frontShmSlotStride(capacity_));
+            const uint64_t before = slot->sequence.load(std::memory_order_acquire);
+            const uint64_t generation = slot->generation;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((before & 1) == 0 && slot->sequence.load(std::memory_order_relaxed) == before) {
+                return static_cast<int64_t>(generation);
+            }
+        }
+        return -1;
+    }
+
+    uint32_t FrontReader::writerPid() const {
+        return static_cast<const FrontShmHeader*>(shm_base)->writer_pid;
+    }
+} // namespace charge_schedule
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "bounded_queue.hpp"
+#include "generation_observer.hpp"
+#include "nsgaii.hpp"
+
+namespace nsgaii
+{
+   GenerationView::GenerationView(int generation, double hypervolume, const Individual* population, std::size_t size,
+                                  const std::vector<std::vector<int>>& fronts)
+   : generation_(generation), hypervolume_(hypervolume), population(population), size_(size), fronts(&fronts)
+   {
+   }
+
+   const Individual& GenerationView::operator[](std::size_t index) const {
+      return population[index];
+   }
+
+   const Individual* GenerationView::end() const {
+      return population + size_;
+   }
+
+   void groupFronts(const Individual* population, std::size_t size, std::vector<std::vector<int>>& fronts) {
+      for (std::vector<int>& front : fronts) {
+         front.clear();
+      }
+      std::size_t used = 0;
+      for (std::size_t i = 0; i < size; ++i) {
+         const std::size_t rank = std::max(0, population[i].fronts_count);
+         if (fronts.size() <= rank) {
+            fronts.resize(rank + 1);
+         }
+         fronts[rank].push_back(static_cast<int>(i));
+         used = std::max(used, rank + 1);
+      }
+      fronts.resize(used);
+   }
+
+   // 非同期の配信スレッド
+   // 世代ごとの複製（個体群・前線・その時点の観測者）を容量付きキューで受け取り，順に配信する
+   class ObserverRegistry::Dispatcher
+   {
+   public:
+      struct Snapshot
+      {
+         int generation;
+         double hypervolume;
+         std::vector<Individual> population;
+         std::vector<std::vector<int>> fronts;
+         std::vector<GenerationObserver> observers;
+      };
+
+      explicit Dispatcher(std::size_t capacity)
+      : queue(capacity), submitted(0), delivered(0)
+      {
+         thread = std::thread(&Dispatcher::loop, this);
+      }
+
+      ~Dispatcher() {
+         queue.push(nullptr);
+         thread.join();
+      }
+
+      void submit(std::shared_ptr<Snapshot> snapshot) {
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++submitted;
+         }
+         queue.push(std::move(snapshot));
+      }
+
+      void flush() {
+         std::unique_lock<std::mutex> lock(mutex);
+         done.wait(lock, [this] { return delivered == submitted; });
+      }
+
+   private:
+      void loop() {
+         while (true) {
+            std::shared_ptr<Snapshot> snapshot = queue.pop();
+            if (!snapshot) {
+               return;
+            }
+            GenerationView view(snapshot->generation, snapshot->hypervolume, snapshot->population.data(),
+                                snapshot->population.size(), snapshot->fronts);
+            for (const GenerationObserver& observer : snapshot->observers) {
+               try {
+                  observer(view);
+               } catch (const std::exception& e) {
+                  std::cerr << "世代" << snapshot->generation << "の観測者が例外を投げました: " << e.what() << std::endl;
+               }
+            }
+            {
+               std::lock_guard<std::mutex> lock(mutex);
+               ++delivered;
+            }
+            done.notify_all();
+         }
+      }
+
+      BoundedQueue<std::shared_ptr<Snapshot>> queue;
+      std::mutex mutex;
+      std::condition_variable done;
+      std::size_t submitted;
+      std::size_t delivered;
+      std::thread thread;
+   };
+
+   ObserverRegistry::ObserverRegistry()
+   : next_id(0), queue_capacity(4)
+   {
+   }
+
+   ObserverRegistry::~ObserverRegistry() = default;
+
+   ObserverRegistry::ObserverRegistry(const ObserverRegistry&)
+   : ObserverRegistry()
+   {
+   }
+
+   ObserverRegistry& ObserverRegistry::operator=(const ObserverRegistry&) {
+      // 自身の観測者はそのまま残す（配信中のものを途中で外さない）
+      return *this;
+   }
+
+   int ObserverRegistry::add(GenerationObserver observer, ObserverDispatch dispatch, std::size_t queue_capacity) {
+      if (!observer) {
+         std::cerr << "観測者が空です" << std::endl;
+         throw std::invalid_argument("observer is empty");
+      }
+      if (dispatch == ObserverDispatch::Asynchronous && !dispatcher) {
+         this->queue_capacity = std::max<std::size_t>(1, queue_capacity);
+         dispatcher = std::make_unique<Dispatcher>(this->queue_capacity);
+      }
+      entries.push_back({next_id, std::move(observer), dispatch});
+      return next_id++;
+   }
+
+   void ObserverRegistry::remove(int id) {
+      entries.erase(std::remove_if(entries.begin(), entries.end(), [id](const Entry& entry) { return entry.id == id; }), entries.end());
+   }
+
+   void ObserverRegistry::notify(int generation, double hypervolume, const std::vector<Individual>& population) {
+      if (entries.empty()) {
+         return;
+      }
+      groupFronts(population.data(), population.size(), fronts);
+
+      std::shared_ptr<Dispatcher::Snapshot> snapshot;
+      for (const Entry& entry : entries) {
+         if (entry.dispatch != ObserverDispatch::Asynchronous) continue;
+         if (!snapshot) {
+            snapshot = std::make_shared<Dispatcher::Snapshot>();
+            snapshot->generation = generation;
+            snapshot->hypervolume = hypervolume;
+            snapshot->population = population;
+            snapshot->fronts = fronts;
+         }
+         snapshot->observers.push_back(entry.observer);
+      }
+      if (snapshot) {
+         dispatcher->submit(std::move(snapshot));
+      }
+
+      GenerationView view(generation, hypervolume, population.data(), population.size(), fronts);
+      for (const Entry& entry : entries) {
+         if (entry.dispatch == ObserverDispatch::Synchronous) {
+            entry.observer(view);
+         }
+      }
+   }
+
+   void ObserverRegistry::flush() {
+      if (dispatcher) {
+         dispatcher->flush();
+      }
+   }
+} // namespace nsgaii
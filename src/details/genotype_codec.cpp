@@ -0,0 +1,34 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "genotype_codec.hpp"
+
+namespace charge_schedule
+{
+    void encodeGenotype(const nsgaii::Individual& individual, CompactGenotype& genotype) {
+        if (individual.charging_number < 0 || individual.charging_number > kCompactMaxCharge) {
+            std::cerr << "charging_numberが圧縮遺伝子型の上限を超えています: " << individual.charging_number << std::endl;
+            throw std::out_of_range("charging_number exceeds kCompactMaxCharge");
+        }
+        if (individual.first_soc < 0 || individual.first_soc > 255) {
+            std::cerr << "first_socが圧縮遺伝子型の範囲外です: " << individual.first_soc << std::endl;
+            throw std::out_of_range("first_soc is out of range");
+        }
+        genotype.charging_number = static_cast<uint8_t>(individual.charging_number);
+        genotype.first_soc = static_cast<uint8_t>(individual.first_soc);
+        for (int i = 0; i < individual.charging_number; ++i) {
+            int position = individual.charging_position[i];
+            int cycle = individual.cycle_count[i];
+            int soc = individual.soc_chromosome[i];
+            if (position < 0 || position > 1 || cycle < 0 || cycle > kCompactMaxCycle || soc < 0 || soc > 255) {
+                std::cerr << "遺伝子が圧縮遺伝子型の範囲外です: (" << position << ", " << cycle << ", " << soc << ")" << std::endl;
+                throw std::out_of_range("gene is out of range");
+            }
+            genotype.genes[i] = packGene(position, cycle, soc);
+        }
+    }
+
+    size_t encodedSize(const CompactGenotype& genotype) {
+        return offsetof(CompactGenotype, genes) + sizeof(uint16_t) * genotype.charging_number;
+    }
+} // namespace charge_schedule
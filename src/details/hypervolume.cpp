@@ -0,0 +1,119 @@
+#include <iterator>
+#include <stdexcept>
+
+#include "hypervolume.hpp"
+
+namespace nsgaii {
+   HypervolumeTracker::HypervolumeTracker(float f1_reference, float f2_reference)
+   : hypervolume_(0.0), f1_reference(f1_reference), f2_reference(f2_reference)
+   {
+   }
+
+   void HypervolumeTracker::setReference(float f1_reference, float f2_reference) {
+      this->f1_reference = f1_reference;
+      this->f2_reference = f2_reference;
+      clear();
+   }
+
+   void HypervolumeTracker::clear() {
+      front.clear();
+      by_contribution.clear();
+      hypervolume_ = 0.0;
+   }
+
+   bool HypervolumeTracker::insert(float f1, float f2) {
+      if (f1 >= f1_reference || f2 >= f2_reference) {
+         return false; // 参照点を支配しない点は寄与0
+      }
+
+      // f1が同じかそれより小さい点のうち，最も右の点に支配されるか確認
+      FrontMap::iterator it = front.upper_bound(f1);
+      if (it != front.begin() && std::prev(it)->second.f2 <= f2) {
+         return false;
+      }
+
+      // 新しい点に支配される点（f1 >= f1 かつ f2 >= f2）は連続して並ぶ
+      it = front.lower_bound(f1);
+      while (it != front.end() && it->second.f2 >= f2) {
+         FrontMap::iterator next = std::next(it);
+         eraseAt(it);
+         it = next;
+      }
+
+      it = front.emplace(f1, Entry{f2, 0.0}).first;
+      refreshContribution(it);
+      hypervolume_ += it->second.contribution;
+      if (it != front.begin()) refreshContribution(std::prev(it));
+      if (std::next(it) != front.end()) refreshContribution(std::next(it));
+      return true;
+   }
+
+   bool HypervolumeTracker::erase(float f1, float f2) {
+      FrontMap::iterator it = front.find(f1);
+      if (it == front.end() || it->second.f2 != f2) {
+         return false;
+      }
+      eraseAt(it);
+      return true;
+   }
+
+   bool HypervolumeTracker::contains(float f1, float f2) const {
+      FrontMap::const_iterator it = front.find(f1);
+      return it != front.end() && it->second.f2 == f2;
+   }
+
+   double HypervolumeTracker::contribution(float f1, float f2) const {
+      FrontMap::const_iterator it = front.find(f1);
+      if (it == front.end() || it->second.f2 != f2) {
+         return 0.0;
+      }
+      return it->second.contribution;
+   }
+
+   std::pair<float, float> HypervolumeTracker::minContributor() const {
+      if (by_contribution.empty()) {
+         throw std::out_of_range("HypervolumeTracker is empty.");
+      }
+      float f1 = by_contribution.begin()->second;
+      return std::make_pair(f1, front.at(f1).f2);
+   }
+
+   std::pair<float, float> HypervolumeTracker::popMinContributor() {
+      std::pair<float, float> point = minContributor();
+      eraseAt(front.find(point.first));
+      return point;
+   }
+
+   std::vector<std::pair<float, float>> HypervolumeTracker::points() const {
+      std::vector<std::pair<float, float>> result;
+      result.reserve(front.size());
+      for (const auto& entry : front) {
+         result.emplace_back(entry.first, entry.second.f2);
+      }
+      return result;
+   }
+
+   double HypervolumeTracker::calcContribution(FrontMap::const_iterator it) const {
+      // 右隣のf1と左隣のf2で囲まれる長方形が排他的寄与量
+      FrontMap::const_iterator next = std::next(it);
+      double right = (next != front.end()) ? next->first : f1_reference;
+      double upper = (it != front.begin()) ? std::prev(it)->second.f2 : f2_reference;
+      return (right - it->first) * (upper - it->second.f2);
+   }
+
+   void HypervolumeTracker::refreshContribution(FrontMap::iterator it) {
+      by_contribution.erase({it->second.contribution, it->first});
+      it->second.contribution = calcContribution(it);
+      by_contribution.insert({it->second.contribution, it->first});
+   }
+
+   void HypervolumeTracker::eraseAt(FrontMap::iterator it) {
+      hypervolume_ -= it->second.contribution;
+      by_contribution.erase({it->second.contribution, it->first});
+
+      FrontMap::iterator next = front.erase(it);
+      if (next != front.end()) refreshContribution(next);
+      if (next != front.begin()) refreshContribution(std::prev(next));
+      if (front.empty()) hypervolume_ = 0.0; // 丸め誤差の蓄積をリセット
+   }
+} // namespace nsgaii
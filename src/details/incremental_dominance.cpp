@@ -0,0 +1,83 @@
+#include "incremental_dominance.hpp"
+
+namespace nsgaii
+{
+   void IncrementalDominance::clear() {
+      // 支配リストの領域は次の世代で再利用する
+      for (std::size_t i = 0; i < size_; ++i) {
+         dominates[i].clear();
+      }
+      size_ = 0;
+   }
+
+   void IncrementalDominance::reserve(std::size_t size) {
+      f1_values.reserve(size);
+      f2_values.reserve(size);
+      dominated_count.reserve(size);
+      if (dominates.size() < size) {
+         dominates.resize(size);
+      }
+   }
+
+   std::size_t IncrementalDominance::add(float f1, float f2) {
+      const std::size_t m = size_;
+      f1_values.resize(m + 1);
+      f2_values.resize(m + 1);
+      dominated_count.resize(m + 1);
+      if (dominates.size() < m + 1) {
+         dominates.resize(m + 1);
+      }
+      f1_values[m] = f1;
+      f2_values[m] = f2;
+      dominated_count[m] = 0;
+
+      // ScheduleNsgaii::dominatingと同じ判定
+      for (std::size_t k = 0; k < m; ++k) {
+         const float k1 = f1_values[k];
+         const float k2 = f2_values[k];
+         if (k1 <= f1 && k2 <= f2 && (k1 < f1 || k2 < f2)) {
+            dominates[k].push_back(static_cast<int>(m));
+            ++dominated_count[m];
+         } else if (f1 <= k1 && f2 <= k2 && (f1 < k1 || f2 < k2)) {
+            dominates[m].push_back(static_cast<int>(k));
+            ++dominated_count[k];
+         }
+      }
+      ++size_;
+      return m;
+   }
+
+   std::vector<std::vector<int>> IncrementalDominance::fronts() const {
+      std::vector<std::vector<int>> fronts;
+      if (size_ == 0) {
+         return fronts;
+      }
+
+      std::vector<int> count(dominated_count.begin(), dominated_count.begin() + size_);
+      std::vector<int> first_front;
+      for (std::size_t i = 0; i < size_; ++i) {
+         if (count[i] == 0) {
+            first_front.push_back(static_cast<int>(i));
+         }
+      }
+      fronts.push_back(first_front);
+
+      std::size_t processed = first_front.size();
+      while (processed < size_) {
+         std::vector<int> next_front;
+         for (int point : fronts.back()) {
+            for (int dominated : dominates[point]) {
+               if (--count[dominated] == 0) {
+                  next_front.push_back(dominated);
+               }
+            }
+         }
+         if (next_front.empty()) {
+            break;
+         }
+         processed += next_front.size();
+         fronts.push_back(std::move(next_front));
+      }
+      return fronts;
+   }
+} // namespace nsgaii
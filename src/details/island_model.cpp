@@ -0,0 +1,161 @@
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "island_model.hpp"
+
+namespace charge_schedule
+{
+    MigrationMailbox::MigrationMailbox(size_t capacity)
+    : head(0), tail(0)
+    {
+        // インデックス計算をマスクで行うため容量を2のべき乗に切り上げる
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    bool MigrationMailbox::push(const nsgaii::Individual& individual) {
+        size_t current_tail = tail.load(std::memory_order_relaxed);
+        if (current_tail - head.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        encodeGenotype(individual, slots[current_tail & mask]);
+        tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool MigrationMailbox::pop(CompactGenotype& genotype) {
+        size_t current_head = head.load(std::memory_order_relaxed);
+        if (current_head == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        genotype = slots[current_head & mask];
+        head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    IslandModel::IslandModel(const std::string& config_file_path, const IslandModelOptions& options)
+    : options(options), elapsed_seconds(0)
+    {
+        if (options.island_count <= 0) {
+            std::cerr << "island_countが無効です: " << options.island_count << std::endl;
+            throw std::invalid_argument("island_count is invalid");
+        }
+        if (options.migration_interval <= 0 || options.migration_size < 0) {
+            std::cerr << "移住設定が無効です: " << options.migration_interval << ", " << options.migration_size << std::endl;
+            throw std::invalid_argument("migration options are invalid");
+        }
+
+        // YAMLの読み込みは1回のみとし，各島は複製して作成する
+        TwoTransProblem prototype(config_file_path);
+        for (int i = 0; i < options.island_count; ++i) {
+            std::unique_ptr<TwoTransProblem> island = std::make_unique<TwoTransProblem>(prototype);
+            island->setSeed(options.base_seed + 7919u * static_cast<unsigned int>(i));
+            if (!options.eta_sbx_values.empty()) {
+                island->setEtaSBX(options.eta_sbx_values[i % options.eta_sbx_values.size()]);
+            }
+            if (!options.eta_m_values.empty()) {
+                island->setEtaM(options.eta_m_values[i % options.eta_m_values.size()]);
+            }
+            islands.push_back(std::move(island));
+            mailboxes.push_back(std::make_unique<MigrationMailbox>(4 * options.migration_size));
+        }
+        progress_.resize(options.island_count);
+    }
+
+    void IslandModel::run() {
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        threads.reserve(islands.size());
+        for (int i = 0; i < static_cast<int>(islands.size()); ++i) {
+            threads.emplace_back(&IslandModel::runIsland, this, i);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void IslandModel::runIsland(int island_id) {
+        auto start = std::chrono::steady_clock::now();
+        TwoTransProblem& island = *islands[island_id];
+        std::vector<IslandProgress>& history = progress_[island_id];
+        history.reserve(options.max_generation + 1);
+
+        island.setInitialThreads(1); // 島ごとにスレッドを使っているため初期個体群は逐次に生成する
+        island.generateFirstParents();
+        island.evaluatePopulation(island.parents);
+        island.sortPopulation(island.parents);
+        double hyper_volume = island.updateArchiveHypervolume(island.parents);
+        history.push_back({0, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), hyper_volume});
+
+        for (int generation = 1; generation <= options.max_generation; ++generation) {
+            island.generateChildren(options.random_selection);
+            island.evaluatePopulation(island.children);
+            island.generateCombinedPopulation();
+            island.sortPopulation(island.combind_population);
+            island.generateParents();
+
+            if (islands.size() > 1 && generation % options.migration_interval == 0) {
+                emigrate(island_id);
+                immigrate(island_id);
+            }
+
+            hyper_volume = island.updateArchiveHypervolume(island.children);
+            history.push_back({generation, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), hyper_volume});
+        }
+    }
+
+    void IslandModel::emigrate(int island_id) {
+        // 親個体群はソート済みのため先頭からフロント0の個体を送る
+        const TwoTransProblem& island = *islands[island_id];
+        MigrationMailbox& destination = *mailboxes[(island_id + 1) % islands.size()];
+        int sent = 0;
+        for (const auto& individual : island.parents) {
+            if (sent >= options.migration_size || individual.fronts_count != 0) break;
+            if (!destination.push(individual)) break;
+            ++sent;
+        }
+    }
+
+    void IslandModel::immigrate(int island_id) {
+        // 受け取った移住個体で親個体群の末尾（劣る個体）を置き換える
+        TwoTransProblem& island = *islands[island_id];
+        MigrationMailbox& source = *mailboxes[island_id];
+        CompactGenotype migrant;
+        size_t received = 0;
+        while (received < island.parents.size() && source.pop(migrant)) {
+            island.decodeGenotype(migrant, island.parents[island.parents.size() - 1 - received]);
+            ++received;
+        }
+        if (received > 0) {
+            island.sortPopulation(island.parents);
+        }
+    }
+
+    std::vector<nsgaii::Individual> IslandModel::mergedFront() {
+        std::vector<nsgaii::Individual> merged;
+        for (const auto& island : islands) {
+            merged.insert(merged.end(), island->parents.begin(), island->parents.end());
+        }
+        islands.front()->sortPopulation(merged);
+
+        std::vector<nsgaii::Individual> front;
+        for (const auto& individual : merged) {
+            if (individual.fronts_count != 0) break;
+            front.push_back(individual);
+        }
+        return front;
+    }
+
+    double IslandModel::mergedHypervolume() {
+        std::pair<float, float> reference = islands.front()->hypervolumeReference();
+        return islands.front()->calculateHypervolume(mergedFront(), reference.first, reference.second);
+    }
+} // namespace charge_schedule
@@ -2,11 +2,22 @@
 #include <memory>
 #include <random>
 #include <iostream>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <thread>
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
 #include <yaml-cpp/yaml.h>
+#endif
 
 #include "nsgaii.hpp"
 
 namespace nsgaii {
+   namespace
+   {
+      thread_local std::mt19937* scoped_engine = nullptr;
+   } // namespace
+
    Individual::Individual(const int& chromosome_size)
    : time_chromosome(chromosome_size, 0), 
    soc_chromosome(chromosome_size, 0), 
@@ -15,6 +26,7 @@ namespace nsgaii {
    charging_number(chromosome_size), 
    penalty(0), 
    fronts_count(0), 
+   congestion(0),
    first_soc(100),
    elapsed_time(0.0f)
    {
@@ -28,7 +40,8 @@ namespace nsgaii {
       cycle_count.resize(chromosome_size + 1, 0);
    }
 
-   ScheduleNsgaii::ScheduleNsgaii(const std::string& config_file_path) {
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+   ScheduleParameters loadScheduleParameters(const std::string& config_file_path) {
       YAML::Node node;
       try {
          node = YAML::LoadFile(config_file_path);
@@ -38,53 +51,150 @@ namespace nsgaii {
       }
 
       YAML::Node config = node["charge_schedule"];
+      ScheduleParameters parameters;
 
       // visited_number の設定と検証
-      visited_number = config["visited_number"].as<int>();
-      if (visited_number <= 0) {
-         std::cerr << "visited_numberが無効です: " << visited_number << std::endl;
+      parameters.visited_number = config["visited_number"].as<int>();
+      if (parameters.visited_number <= 0) {
+         std::cerr << "visited_numberが無効です: " << parameters.visited_number << std::endl;
          throw std::invalid_argument("visited_number is invalid");
       }
 
-      // サイズのリサイズと初期化
-      T_move.resize(visited_number);
-      T_standby.resize(visited_number);
-      T_cs.resize(visited_number);
-      E_move.resize(visited_number);
-      E_standby.resize(visited_number);
-      E_cs.resize(visited_number);
-
       // YAMLからデータを読み込み
-      for (size_t i = 0; i < visited_number; ++i) {
-         T_move[i] = config["T_move"][i].as<float>();
-         T_standby[i] = config["T_standby"][i].as<float>();
-         T_cs[i] = config["T_cs"][i].as<float>();
-         E_move[i] = config["E_move"][i].as<float>();
-         E_standby[i] = config["E_standby"][i].as<float>();
-         E_cs[i] = config["E_cs"][i].as<float>();
+      for (size_t i = 0; i < parameters.visited_number; ++i) {
+         parameters.T_move.push_back(config["T_move"][i].as<float>());
+         parameters.T_standby.push_back(config["T_standby"][i].as<float>());
+         parameters.T_cs.push_back(config["T_cs"][i].as<float>());
+         parameters.E_move.push_back(config["E_move"][i].as<float>());
+         parameters.E_standby.push_back(config["E_standby"][i].as<float>());
+         parameters.E_cs.push_back(config["E_cs"][i].as<float>());
       }
 
       // その他のパラメータの設定
-      population_size = config["population_size"].as<int>();
-      T_max = config["T_max"].as<int>();
-      max_charge_number = config["max_charge_number"].as<int>();
-      W_target = config["W_target"].as<int>();
-      SOC_Hi = config["SOC_Hi"].as<int>();
-      SOC_Low = config["SOC_Low"].as<int>();
-      SOC_cccv = config["SOC_cccv"].as<int>();
-      r_cc = config["r_cc"].as<float>();
-      r_cv = config["r_cv"].as<float>();
-      charging_minimum = config["charging_minimum"].as<int>();
-      eta_sbx = config["eta_sbx"].as<float>();
-      eta_m = config["eta_m"].as<float>();
-      mutation_probability = config["mutation_probability"].as<float>();
+      parameters.population_size = config["population_size"].as<int>();
+      parameters.T_max = config["T_max"].as<int>();
+      parameters.max_charge_number = config["max_charge_number"].as<int>();
+      parameters.W_target = config["W_target"].as<int>();
+      parameters.SOC_Hi = config["SOC_Hi"].as<int>();
+      parameters.SOC_Low = config["SOC_Low"].as<int>();
+      parameters.SOC_cccv = config["SOC_cccv"].as<int>();
+      parameters.r_cc = config["r_cc"].as<float>();
+      parameters.r_cv = config["r_cv"].as<float>();
+      parameters.charging_minimum = config["charging_minimum"].as<int>();
+      parameters.eta_sbx = config["eta_sbx"].as<float>();
+      parameters.eta_m = config["eta_m"].as<float>();
+      parameters.mutation_probability = config["mutation_probability"].as<float>();
+
+      // 生存選択方式（省略時は混雑距離）
+      if (config["survivor_selection"]) {
+         std::string selection = config["survivor_selection"].as<std::string>();
+         if (selection == "hypervolume") {
+            parameters.survivor_selection = SurvivorSelection::Hypervolume;
+         } else if (selection != "crowding") {
+            std::cerr << "survivor_selectionが無効です: " << selection << std::endl;
+            throw std::invalid_argument("survivor_selection is invalid");
+         }
+      }
+
+      // 初期個体群の生成方式（省略時は一様乱数）
+      if (config["initial_sampler"]) {
+         std::string sampler = config["initial_sampler"].as<std::string>();
+         if (sampler == "latin_hypercube") {
+            parameters.initial_sampler = InitialSampler::LatinHypercube;
+         } else if (sampler != "uniform") {
+            std::cerr << "initial_samplerが無効です: " << sampler << std::endl;
+            throw std::invalid_argument("initial_sampler is invalid");
+         }
+      }
+
+      // 子個体の生成方式（省略時はペアごと）
+      if (config["crossover_mode"]) {
+         std::string mode = config["crossover_mode"].as<std::string>();
+         if (mode == "batch") {
+            parameters.crossover_mode = CrossoverMode::Batch;
+         } else if (mode != "per_pair") {
+            std::cerr << "crossover_modeが無効です: " << mode << std::endl;
+            throw std::invalid_argument("crossover_mode is invalid");
+         }
+      }
+
+      // 子個体生成・評価のスレッド数（省略時は逐次）
+      if (config["worker_threads"]) {
+         parameters.worker_threads = config["worker_threads"].as<int>();
+      }
+
+      // 初期個体群の並列生成スレッド数（省略時は逐次）
+      if (config["initial_threads"]) {
+         parameters.initial_threads = config["initial_threads"].as<int>();
+      }
+
+      // ハイパーボリューム参照点（省略時は最大作業時間）
+      parameters.hv_reference = std::make_pair<float, float>(parameters.T_max, parameters.T_max);
+      if (config["hv_reference"]) {
+         parameters.hv_reference.first = config["hv_reference"][0].as<float>();
+         parameters.hv_reference.second = config["hv_reference"][1].as<float>();
+      }
+      return parameters;
+   }
+
+   ScheduleNsgaii::ScheduleNsgaii(const std::string& config_file_path)
+   : ScheduleNsgaii(loadScheduleParameters(config_file_path))
+   {
+   }
+#endif
+
+   ScheduleNsgaii::ScheduleNsgaii(const ScheduleParameters& parameters)
+   : initial_threads(1), worker_threads(1), engine(std::random_device{}()), realtime(false)
+   {
+      visited_number = parameters.visited_number;
+      if (visited_number <= 0) {
+         std::cerr << "visited_numberが無効です: " << visited_number << std::endl;
+         throw std::invalid_argument("visited_number is invalid");
+      }
+      for (const std::vector<float>* values : {&parameters.T_move, &parameters.T_standby, &parameters.T_cs,
+                                               &parameters.E_move, &parameters.E_standby, &parameters.E_cs}) {
+         if (values->size() != static_cast<size_t>(visited_number)) {
+            std::cerr << "訪問先ごとのパラメータの数がvisited_numberと一致しません: " << values->size() << std::endl;
+            throw std::invalid_argument("per-site parameter size does not match visited_number");
+         }
+      }
+      T_move = parameters.T_move;
+      T_standby = parameters.T_standby;
+      T_cs = parameters.T_cs;
+      E_move = parameters.E_move;
+      E_standby = parameters.E_standby;
+      E_cs = parameters.E_cs;
+
+      population_size = parameters.population_size;
+      T_max = parameters.T_max;
+      max_charge_number = parameters.max_charge_number;
+      W_target = parameters.W_target;
+      SOC_Hi = parameters.SOC_Hi;
+      SOC_Low = parameters.SOC_Low;
+      SOC_cccv = parameters.SOC_cccv;
+      r_cc = parameters.r_cc;
+      r_cv = parameters.r_cv;
+      charging_minimum = parameters.charging_minimum;
+      eta_sbx = parameters.eta_sbx;
+      eta_m = parameters.eta_m;
+      mutation_probability = parameters.mutation_probability;
+      sbx_table.build(eta_sbx);
+      mutation_table.build(eta_m);
+
+      survivor_selection = parameters.survivor_selection;
+      initial_sampler = parameters.initial_sampler;
+      crossover_mode = parameters.crossover_mode;
+      setWorkerThreads(parameters.worker_threads);
+      setInitialThreads(parameters.initial_threads);
+
+      f1_reference = parameters.hv_reference.first;
+      f2_reference = parameters.hv_reference.second;
+      archive_tracker.setReference(f1_reference, f2_reference);
 
       // 個体の初期化
       parents.resize(population_size, Individual(max_charge_number));
       children.resize(population_size, Individual(max_charge_number));
       combind_population.resize(2*population_size, Individual(max_charge_number));
-
-
    }
 
    void ScheduleNsgaii::generateParents() {
@@ -220,6 +330,12 @@ namespace nsgaii {
    }
 
    void ScheduleNsgaii::generateCombinedPopulation() {
+      if (realtime) {
+         // 確保済みの個体へ代入し，染色体の容量を使い回す
+         std::copy(parents.begin(), parents.end(), combind_population.begin());
+         std::copy(children.begin(), children.end(), combind_population.begin() + parents.size());
+         return;
+      }
       combind_population.clear();
       combind_population.reserve(parents.size() + children.size());
       combind_population.insert(combind_population.end(), parents.begin(), parents.end());
@@ -379,7 +495,63 @@ namespace nsgaii {
     population = std::move(sorted_population);
 }
 
+   void ScheduleNsgaii::hypervolumeSorting(std::vector<std::vector<int>> fronts, std::vector<Individual>& population) {
+      // SMS-EMOA: 各フロント内で排他的寄与量の最も小さい個体を順に取り除き，
+      // 取り除いた順の逆を優先順位とする
+      for (auto& front : fronts) {
+         if (front.size() < 2) continue;
+
+         float front_f1_max = population[front.front()].f1;
+         float front_f2_max = population[front.front()].f2;
+         for (int index : front) {
+            front_f1_max = std::max(front_f1_max, population[index].f1);
+            front_f2_max = std::max(front_f2_max, population[index].f2);
+         }
+         // 参照点を超える個体が含まれるフロントはナディア点+1を参照点とする
+         float f1_ref = (front_f1_max < f1_reference) ? f1_reference : front_f1_max + 1.0f;
+         float f2_ref = (front_f2_max < f2_reference) ? f2_reference : front_f2_max + 1.0f;
+
+         HypervolumeTracker tracker(f1_ref, f2_ref);
+         std::map<std::pair<float, float>, int> point_index;
+         for (int index : front) {
+            if (tracker.insert(population[index].f1, population[index].f2)) {
+               point_index[{population[index].f1, population[index].f2}] = index;
+            }
+         }
+
+         std::vector<int> removed_order;
+         removed_order.reserve(tracker.size());
+         while (!tracker.empty()) {
+            removed_order.push_back(point_index.at(tracker.popMinContributor()));
+         }
+
+         // 同じ評価値を持つ個体など，寄与0の個体は末尾へ
+         std::vector<bool> placed(population.size(), false);
+         std::vector<int> sorted_front(removed_order.rbegin(), removed_order.rend());
+         for (int index : sorted_front) {
+            placed[index] = true;
+         }
+         for (int index : front) {
+            if (!placed[index]) sorted_front.push_back(index);
+         }
+         front = std::move(sorted_front);
+      }
+
+      std::vector<Individual> sorted_population;
+      sorted_population.reserve(population.size());
+      for (const auto& front : fronts) {
+         for (int individual : front) {
+            sorted_population.push_back(population[individual]);
+         }
+      }
+      population = std::move(sorted_population);
+   }
+
    void ScheduleNsgaii::sortPopulation(std::vector<Individual>& population) {
+      if (realtime && population.size() <= sort_workspace.Np.size()) {
+         sortPopulationRealtime(population);
+         return;
+      }
       std::vector<std::vector<int>> fronts = nonDominatedSorting(population);
       // std::cout << "渡し" << std::endl;
       // for (auto& front : fronts) {
@@ -389,8 +561,21 @@ namespace nsgaii {
       //    std::cout << std::endl;
       // }
       // std::cout << std::endl;
+      sortPopulationByFronts(fronts, population);
+   }
+
+   void ScheduleNsgaii::sortPopulationByFronts(const std::vector<std::vector<int>>& fronts, std::vector<Individual>& population) {
+      for (size_t front = 0; front < fronts.size(); ++front) {
+         for (int index : fronts[front]) {
+            population[index].fronts_count = front;
+         }
+      }
 
-      crowdingSorting(fronts, population);
+      if (survivor_selection == SurvivorSelection::Hypervolume) {
+         hypervolumeSorting(fronts, population);
+      } else {
+         crowdingSorting(fronts, population);
+      }
       std::stable_sort(population.begin(), population.end(),
                   [](const Individual& a, const Individual& b) {
                         return a.penalty < b.penalty; // penaltyが少ないものを優先
@@ -400,11 +585,135 @@ namespace nsgaii {
       }
    }
 
+   void ScheduleNsgaii::sortPopulationRealtime(std::vector<Individual>& population) {
+      SortWorkspace& workspace = sort_workspace;
+      const size_t n = population.size();
+      if (n == 0) {
+         return;
+      }
+
+      // 非支配ソート（nonDominatedSortingと同じ順序でフロントを作る）
+      std::fill(workspace.dominated_count.begin(), workspace.dominated_count.begin() + n, 0);
+      std::fill(workspace.Np.begin(), workspace.Np.begin() + n, 0);
+      for (size_t i = 0; i < n; ++i) {
+         for (size_t j = i + 1; j < n; ++j) {
+            if (dominating(population[i], population[j])) {
+               workspace.dominated[i * n + workspace.dominated_count[i]++] = j;
+               ++workspace.Np[j];
+            } else if (dominating(population[j], population[i])) {
+               workspace.dominated[j * n + workspace.dominated_count[j]++] = i;
+               ++workspace.Np[i];
+            }
+         }
+      }
+
+      workspace.front_order.clear();
+      workspace.front_begin.clear();
+      workspace.front_begin.push_back(0);
+      for (size_t i = 0; i < n; ++i) {
+         if (workspace.Np[i] == 0) {
+            workspace.front_order.push_back(i);
+         }
+      }
+      while (workspace.front_order.size() > static_cast<size_t>(workspace.front_begin.back())) {
+         const int front = workspace.front_begin.size() - 1;
+         const int begin = workspace.front_begin.back();
+         const int end = workspace.front_order.size();
+         workspace.front_begin.push_back(end);
+         for (int k = begin; k < end; ++k) {
+            const int individual = workspace.front_order[k];
+            population[individual].fronts_count = front;
+            for (int d = 0; d < workspace.dominated_count[individual]; ++d) {
+               const int dominated = workspace.dominated[individual * n + d];
+               if (--workspace.Np[dominated] == 0) {
+                  workspace.front_order.push_back(dominated);
+               }
+            }
+         }
+      }
+
+      // フロントごとの混雑距離順（crowdingSortingと同じ比較・同じ順序でソートする）
+      std::vector<std::pair<int, float>>& indexed_front = workspace.indexed_front;
+      for (size_t front = 0; front + 1 < workspace.front_begin.size(); ++front) {
+         const int begin = workspace.front_begin[front];
+         const int end = workspace.front_begin[front + 1];
+         if (end - begin < 2) continue;
+
+         indexed_front.clear();
+         for (int k = begin; k < end; ++k) {
+            indexed_front.push_back({workspace.front_order[k], 0.0f});
+         }
+         for (size_t obj = 0; obj < 2; ++obj) {
+            std::sort(indexed_front.begin(), indexed_front.end(), [&](const std::pair<int, float>& a, const std::pair<int, float>& b) {
+               return (obj == 0) ? population[a.first].f1 < population[b.first].f1 : population[a.first].f2 < population[b.first].f2;
+            });
+            indexed_front.front().second = std::numeric_limits<float>::infinity();
+            indexed_front.back().second = std::numeric_limits<float>::infinity();
+
+            const Individual& lowest = population[indexed_front.front().first];
+            const Individual& highest = population[indexed_front.back().first];
+            const float range = (obj == 0) ? highest.f1 - lowest.f1 : highest.f2 - lowest.f2;
+            for (size_t i = 1; i < indexed_front.size() - 1; ++i) {
+               const Individual& previous = population[indexed_front[i - 1].first];
+               const Individual& next = population[indexed_front[i + 1].first];
+               const float diff = (obj == 0) ? next.f1 - previous.f1 : next.f2 - previous.f2;
+               if (range > 0) {
+                  indexed_front[i].second += diff / range;
+               }
+            }
+         }
+         std::sort(indexed_front.begin(), indexed_front.end(), [](const std::pair<int, float>& a, const std::pair<int, float>& b) {
+            return a.second > b.second;
+         });
+         for (int k = begin; k < end; ++k) {
+            workspace.front_order[k] = indexed_front[k - begin].first;
+         }
+      }
+
+      // penaltyの小さい順（同じpenaltyの中はフロント順を保つ．stable_sortは一時領域を確保するため使わない）
+      std::vector<std::pair<int, int>>& ranked = workspace.ranked;
+      ranked.clear();
+      for (size_t position = 0; position < n; ++position) {
+         ranked.push_back({population[workspace.front_order[position]].penalty, static_cast<int>(position)});
+      }
+      std::sort(ranked.begin(), ranked.end());
+      for (std::pair<int, int>& rank : ranked) {
+         rank.second = workspace.front_order[rank.second]; // 新しい位置 -> 元の添字
+      }
+
+      // 置換を巡回ごとに入れ替えで適用する（個体のコピーを作らない）
+      std::fill(workspace.placed.begin(), workspace.placed.begin() + n, 0);
+      for (size_t start = 0; start < n; ++start) {
+         if (workspace.placed[start]) continue;
+         size_t position = start;
+         while (static_cast<size_t>(ranked[position].second) != start) {
+            const size_t source = ranked[position].second;
+            std::swap(population[position], population[source]);
+            workspace.placed[position] = 1;
+            position = source;
+         }
+         workspace.placed[position] = 1;
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+         population[i].fronts_count += population[i].penalty;
+      }
+   }
+
    std::pair<Individual, Individual> ScheduleNsgaii::rankingSelection() {
-      std::pair<Individual, Individual> selected_parents = std::make_pair(Individual(max_charge_number), Individual(max_charge_number));
+      std::pair<int, int> selected = rankingSelectionIndex();
+      return std::make_pair(parents[selected.first], parents[selected.second]);
+   }
+
+   std::pair<Individual, Individual> ScheduleNsgaii::randomSelection() {
+      std::pair<int, int> selected = randomSelectionIndex();
+      return std::make_pair(parents[selected.first], parents[selected.second]);
+   }
+
+   std::pair<int, int> ScheduleNsgaii::rankingSelectionIndex() {
+      std::pair<int, int> selected_index;
 
-      std::random_device rd; // ノイズを使用したシード
-      std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
+      std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
       std::uniform_int_distribution<> select_dist(0, parents.size() - 1);
 
       // 親が異なる評価値を持つまで繰り返す
@@ -412,29 +721,25 @@ namespace nsgaii {
          for (int i = 0; i < 2; ++i) {
                int first = select_dist(gen);
                int second = select_dist(gen);
-               Individual& selected = (first <= second) ? parents[first] : parents[second];
-               (i == 0 ? selected_parents.first : selected_parents.second) = selected;
+               int selected = (first <= second) ? first : second;
+               (i == 0 ? selected_index.first : selected_index.second) = selected;
          }
-      } while (selected_parents.first.f1 == selected_parents.second.f1 &&
-               selected_parents.first.f2 == selected_parents.second.f2);
+      } while (parents[selected_index.first].f1 == parents[selected_index.second].f1 &&
+               parents[selected_index.first].f2 == parents[selected_index.second].f2);
 
       // charging_numberを比較して必要に応じて入れ替え
-      if (selected_parents.first.charging_number > selected_parents.second.charging_number) {
-         std::swap(selected_parents.first, selected_parents.second);
+      if (parents[selected_index.first].charging_number > parents[selected_index.second].charging_number) {
+         std::swap(selected_index.first, selected_index.second);
       }
 
-      return selected_parents;
+      return selected_index;
    }
 
-   std::pair<Individual, Individual> ScheduleNsgaii::randomSelection() {
-      std::pair<Individual, Individual> selected_parents = std::make_pair(Individual(max_charge_number), Individual(max_charge_number));
-
-      std::random_device rd; // ノイズを使用したシード
-      std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
+   std::pair<int, int> ScheduleNsgaii::randomSelectionIndex() {
+      std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
       std::uniform_int_distribution<> select_dist(0, parents.size() - 1);
       // 最初の親を選択
       int first_index = select_dist(gen);
-      selected_parents.first = parents[first_index];
 
       int second_index;
 
@@ -447,14 +752,12 @@ namespace nsgaii {
             parents[first_index].f2 == parents[second_index].f2) // 評価値が異なるかチェック
       );
 
-      selected_parents.second = parents[second_index];
-
        // charging_numberを比較して必要に応じて入れ替え
-      if (selected_parents.first.charging_number > selected_parents.second.charging_number) {
-         std::swap(selected_parents.first, selected_parents.second);
+      if (parents[first_index].charging_number > parents[second_index].charging_number) {
+         std::swap(first_index, second_index);
       }
 
-      return selected_parents;
+      return std::make_pair(first_index, second_index);
    }
 
    void ScheduleNsgaii::mutation() {
@@ -468,10 +771,223 @@ namespace nsgaii {
    }
 
    void ScheduleNsgaii::setEtaSBX(float eta_sbx) {
+      sbx_table.build(eta_sbx);
       this->eta_sbx = eta_sbx;
    }
 
    void ScheduleNsgaii::setEtaM(float eta_m) {
+      mutation_table.build(eta_m);
       this->eta_m = eta_m;
    }
+
+   void ScheduleNsgaii::setMutationProbability(float mutation_probability) {
+      this->mutation_probability = mutation_probability;
+   }
+
+   void ScheduleNsgaii::setPopulationSize(int population_size) {
+      if (population_size <= 0 || population_size % 2 != 0) {
+         std::cerr << "population_sizeが無効です: " << population_size << std::endl;
+         throw std::invalid_argument("population_size is invalid");
+      }
+      this->population_size = population_size;
+      parents.resize(population_size, Individual(max_charge_number));
+      children.resize(population_size, Individual(max_charge_number));
+      combind_population.resize(2*population_size, Individual(max_charge_number));
+      if (realtime) {
+         reserveRealtime();
+      }
+   }
+
+   void ScheduleNsgaii::setMaxChargeNumber(int max_charge_number) {
+      if (max_charge_number <= 0) {
+         std::cerr << "max_charge_numberが無効です: " << max_charge_number << std::endl;
+         throw std::invalid_argument("max_charge_number is invalid");
+      }
+      this->max_charge_number = max_charge_number;
+      parents.assign(population_size, Individual(max_charge_number));
+      children.assign(population_size, Individual(max_charge_number));
+      combind_population.assign(2*population_size, Individual(max_charge_number));
+      if (realtime) {
+         reserveRealtime();
+      }
+   }
+
+   void ScheduleNsgaii::setSeed(unsigned int seed) {
+      engine.seed(seed);
+   }
+
+   void ScheduleNsgaii::setSurvivorSelection(SurvivorSelection survivor_selection) {
+      if (realtime && survivor_selection != SurvivorSelection::Crowding) {
+         std::cerr << "リアルタイムモードでは混雑距離以外の生存選択は使えません" << std::endl;
+         throw std::invalid_argument("realtime mode requires crowding survivor selection");
+      }
+      this->survivor_selection = survivor_selection;
+   }
+
+   void ScheduleNsgaii::setInitialSampler(InitialSampler initial_sampler) {
+      this->initial_sampler = initial_sampler;
+   }
+
+   void ScheduleNsgaii::setInitialThreads(int initial_threads) {
+      if (initial_threads < 0) {
+         std::cerr << "initial_threadsが無効です: " << initial_threads << std::endl;
+         throw std::invalid_argument("initial_threads is invalid");
+      }
+      this->initial_threads = initial_threads;
+   }
+
+   void ScheduleNsgaii::setCrossoverMode(CrossoverMode crossover_mode) {
+      this->crossover_mode = crossover_mode;
+   }
+
+   void ScheduleNsgaii::setWorkerThreads(int worker_threads) {
+      if (worker_threads < 0) {
+         std::cerr << "worker_threadsが無効です: " << worker_threads << std::endl;
+         throw std::invalid_argument("worker_threads is invalid");
+      }
+      if (realtime && worker_threads != 1) {
+         std::cerr << "リアルタイムモードではworker_threadsは1のみ有効です: " << worker_threads << std::endl;
+         throw std::invalid_argument("realtime mode requires worker_threads = 1");
+      }
+      this->worker_threads = worker_threads;
+   }
+
+   void ScheduleNsgaii::setRealtime(bool realtime) {
+      if (realtime) {
+         if (survivor_selection != SurvivorSelection::Crowding) {
+            std::cerr << "リアルタイムモードでは混雑距離以外の生存選択は使えません" << std::endl;
+            throw std::invalid_argument("realtime mode requires crowding survivor selection");
+         }
+         if (worker_threads != 1) {
+            std::cerr << "リアルタイムモードではworker_threadsは1のみ有効です: " << worker_threads << std::endl;
+            throw std::invalid_argument("realtime mode requires worker_threads = 1");
+         }
+         reserveRealtime();
+      }
+      this->realtime = realtime;
+   }
+
+   void ScheduleNsgaii::reserveRealtime() {
+      const size_t capacity = 2 * static_cast<size_t>(population_size);
+      for (std::vector<Individual>* population : {&parents, &children, &combind_population}) {
+         for (Individual& individual : *population) {
+            reserveIndividual(individual);
+         }
+      }
+
+      SortWorkspace& workspace = sort_workspace;
+      workspace.dominated.assign(capacity * capacity, 0);
+      workspace.dominated_count.assign(capacity, 0);
+      workspace.Np.assign(capacity, 0);
+      workspace.placed.assign(capacity, 0);
+      workspace.front_order.reserve(capacity);
+      workspace.front_begin.reserve(capacity + 1);
+      workspace.indexed_front.reserve(capacity);
+      workspace.ranked.reserve(capacity);
+   }
+
+   void ScheduleNsgaii::reserveIndividual(Individual& individual) const {
+      // 派生値の末尾（T_span・T_SOC_HiLow・W・cycle_count）は充電回数 + 1
+      const size_t genes = max_charge_number;
+      individual.time_chromosome.reserve(genes);
+      individual.soc_chromosome.reserve(genes);
+      individual.T_span.reserve(genes + 1);
+      individual.T_SOC_HiLow.reserve(genes + 1);
+      individual.E_return.reserve(genes);
+      individual.soc_charging_start.reserve(genes);
+      individual.W.reserve(genes + 1);
+      individual.charging_position.reserve(genes);
+      individual.return_position.reserve(genes);
+      individual.cycle_count.reserve(genes + 1);
+   }
+
+   void ScheduleNsgaii::parallelFor(std::size_t count, const std::function<void(std::size_t, int)>& body) {
+      int thread_count = (worker_threads > 0) ? worker_threads : std::max(1u, std::thread::hardware_concurrency());
+      if (thread_count == 1) {
+         for (std::size_t index = 0; index < count; ++index) {
+            body(index, 0);
+         }
+         return;
+      }
+      WorkStealingPool& pool = worker_pool.get(thread_count);
+      pool.seed(randomEngine()());
+      pool.run(count, [&pool, &body](std::size_t index, int worker) {
+         RandomEngineScope scope(pool.engine(worker));
+         body(index, worker);
+      });
+   }
+
+   std::vector<WorkStealingPool::WorkerStatistics> ScheduleNsgaii::workerStatistics() const {
+      const WorkStealingPool* pool = worker_pool.current();
+      return pool ? pool->statistics() : std::vector<WorkStealingPool::WorkerStatistics>();
+   }
+
+   void ScheduleNsgaii::resetWorkerStatistics() {
+      WorkStealingPool* pool = worker_pool.current();
+      if (pool) {
+         pool->resetStatistics();
+      }
+   }
+
+   ScheduleNsgaii::RandomEngineScope::RandomEngineScope(std::mt19937& engine)
+   : previous(scoped_engine)
+   {
+      scoped_engine = &engine;
+   }
+
+   ScheduleNsgaii::RandomEngineScope::~RandomEngineScope() {
+      scoped_engine = previous;
+   }
+
+   std::mt19937& ScheduleNsgaii::randomEngine() {
+      return (scoped_engine != nullptr) ? *scoped_engine : engine;
+   }
+
+   void ScheduleNsgaii::setHypervolumeReference(float f1_reference, float f2_reference) {
+      this->f1_reference = f1_reference;
+      this->f2_reference = f2_reference;
+      archive_tracker.setReference(f1_reference, f2_reference);
+   }
+
+   std::pair<float, float> ScheduleNsgaii::hypervolumeReference() const {
+      return std::make_pair(f1_reference, f2_reference);
+   }
+
+   double ScheduleNsgaii::updateArchiveHypervolume(const std::vector<Individual>& population) {
+      // 制約を満たす個体のみをアーカイブへ追加（1個体あたりO(log n)）
+      for (const auto& individual : population) {
+         if (individual.penalty == 0) {
+            archive_tracker.insert(individual.f1, individual.f2);
+         }
+      }
+      return archive_tracker.hypervolume();
+   }
+
+   double ScheduleNsgaii::archiveHypervolume() const {
+      return archive_tracker.hypervolume();
+   }
+
+   void ScheduleNsgaii::resetArchiveHypervolume() {
+      archive_tracker.clear();
+   }
+
+   int ScheduleNsgaii::addObserver(GenerationObserver observer, ObserverDispatch dispatch) {
+      return observers.add(std::move(observer), dispatch);
+   }
+
+   void ScheduleNsgaii::removeObserver(int id) {
+      observers.remove(id);
+   }
+
+   void ScheduleNsgaii::notifyObservers(int generation, double hypervolume) {
+      observers.notify(generation, hypervolume, parents);
+   }
+
+   void ScheduleNsgaii::notifyObservers(int generation, double hypervolume, const std::vector<Individual>& population) {
+      observers.notify(generation, hypervolume, population);
+   }
+
+   void ScheduleNsgaii::flushObservers() {
+      observers.flush();
+   }
 } // namespace nsgaii
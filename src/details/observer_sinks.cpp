@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "observer_sinks.hpp"
+
+namespace charge_schedule
+{
+    nsgaii::GenerationObserver csvSink(const std::string& base_csv_file_path) {
+        // 日時を含むファイルパスを生成（1回の実行の全世代を同じファイルへ追記する）
+        std::time_t now = std::time(nullptr);
+        char date_time[20];
+        std::strftime(date_time, sizeof(date_time), "%Y-%m-%d_%H-%M", std::localtime(&now));
+        std::string csv_file_path = base_csv_file_path + "_" + date_time + ".csv";
+
+        return [csv_file_path](const nsgaii::GenerationView& view) {
+            std::ofstream csvFile(csv_file_path, std::ios::app);
+            if (!csvFile) {
+                std::cerr << "ファイルを開けませんでした！" << std::endl;
+                return;
+            }
+
+            csvFile << "第" << view.generation() << "世代\n";
+
+            for (const nsgaii::Individual& individual : view) {
+                csvFile << "f1" << "," << "f2" << "," << "first_soc" << "," << "front\n";
+                csvFile << individual.f1 << "," << individual.f2 << "," << individual.first_soc << "," << individual.fronts_count << "\n";
+                csvFile << "time" << "\n";
+                for (size_t i = 0; i < individual.time_chromosome.size(); ++i) {
+                    csvFile << individual.time_chromosome[i];
+                    if (i != individual.time_chromosome.size() - 1) {
+                        csvFile << ",";
+                    }
+                }
+                csvFile << "\n";
+
+                csvFile << "soc" << "\n";
+                for (size_t i = 0; i < individual.soc_chromosome.size(); ++i) {
+                    csvFile << individual.soc_chromosome[i];
+                    if (i != individual.soc_chromosome.size() - 1) {
+                        csvFile << ",";
+                    }
+                }
+                csvFile << "\n";
+            }
+        };
+    }
+
+    nsgaii::GenerationObserver sharedMemorySink(std::shared_ptr<FrontPublisher> publisher) {
+        if (!publisher) {
+            std::cerr << "publisherが無効です" << std::endl;
+            throw std::invalid_argument("publisher is invalid");
+        }
+        return [publisher](const nsgaii::GenerationView& view) {
+            publisher->publish(view);
+        };
+    }
+
+    MetricsSink::MetricsSink()
+    : last_time(-1)
+    {
+    }
+
+    nsgaii::GenerationObserver MetricsSink::observer() {
+        return [this](const nsgaii::GenerationView& view) {
+            record(view);
+        };
+    }
+
+    void MetricsSink::record(const nsgaii::GenerationView& view) {
+        const double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        Record record;
+        record.generation = view.generation();
+        record.hypervolume = view.hypervolume();
+        record.front_size = 0;
+        record.min_f1 = 0;
+        record.min_f2 = 0;
+        if (view.frontCount() > 0) {
+            const std::vector<int>& front = view.front(0);
+            for (std::size_t i = 0; i < front.size(); ++i) {
+                const nsgaii::Individual& individual = view[front[i]];
+                if (individual.penalty != 0) continue;
+                record.min_f1 = (record.front_size == 0) ? individual.f1 : std::min(record.min_f1, individual.f1);
+                record.min_f2 = (record.front_size == 0) ? individual.f2 : std::min(record.min_f2, individual.f2);
+                ++record.front_size;
+            }
+        }
+        double penalty_sum = 0;
+        for (const nsgaii::Individual& individual : view) {
+            penalty_sum += individual.penalty;
+        }
+        record.mean_penalty = view.size() ? penalty_sum / view.size() : 0.0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        record.interval_seconds = (last_time < 0) ? 0.0 : now - last_time;
+        last_time = now;
+        records_.push_back(record);
+    }
+
+    std::vector<MetricsSink::Record> MetricsSink::records() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return records_;
+    }
+
+    void MetricsSink::writeCsv(const std::string& csv_file_path) const {
+        std::ofstream csvFile(csv_file_path);
+        if (!csvFile) {
+            std::cerr << "ファイルを開けませんでした: " << csv_file_path << std::endl;
+            return;
+        }
+        csvFile << "generation,front_size,hypervolume,min_f1,min_f2,mean_penalty,interval_seconds\n";
+        for (const Record& record : records()) {
+            csvFile << record.generation << "," << record.front_size << "," << record.hypervolume << "," << record.min_f1 << ","
+                    << record.min_f2 << "," << record.mean_penalty << "," << record.interval_seconds << "\n";
+        }
+    }
+
+    void MetricsSink::print(std::ostream& os) const {
+        const std::vector<Record> snapshot = records();
+        if (snapshot.empty()) {
+            return;
+        }
+        double interval_sum = 0;
+        double interval_max = 0;
+        for (const Record& record : snapshot) {
+            interval_sum += record.interval_seconds;
+            interval_max = std::max(interval_max, record.interval_seconds);
+        }
+        const Record& last = snapshot.back();
+        os << "--- metrics ---" << std::endl;
+        os << "generations: " << snapshot.size() << ", last front size: " << last.front_size << ", last hyper_volume: " << last.hypervolume << std::endl;
+        os << "min f1: " << last.min_f1 << ", min f2: " << last.min_f2 << ", mean penalty: " << last.mean_penalty << std::endl;
+        if (snapshot.size() > 1) {
+            os << "generation interval: mean " << interval_sum / (snapshot.size() - 1) * 1000 << " ms, max " << interval_max * 1000 << " ms" << std::endl;
+        }
+    }
+} // namespace charge_schedule
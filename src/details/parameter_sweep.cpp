@@ -0,0 +1,134 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "parameter_sweep.hpp"
+#include "termination.hpp"
+
+namespace charge_schedule
+{
+    ParameterSweep::ParameterSweep(const std::string& config_file_path, const SweepGrid& grid, const SweepOptions& options)
+    : config_file_path(config_file_path), options(options), prototype(config_file_path)
+    {
+        if (options.repetitions <= 0) {
+            std::cerr << "repetitionsが無効です: " << options.repetitions << std::endl;
+            throw std::invalid_argument("repetitions is invalid");
+        }
+
+        std::vector<float> eta_sbx = grid.eta_sbx.empty() ? std::vector<float>{prototype.getEtaSBX()} : grid.eta_sbx;
+        std::vector<float> eta_m = grid.eta_m.empty() ? std::vector<float>{prototype.getEtaM()} : grid.eta_m;
+        std::vector<float> mutation_probability = grid.mutation_probability.empty() ? std::vector<float>{prototype.getMutationProbability()} : grid.mutation_probability;
+        std::vector<int> population_size = grid.population_size.empty() ? std::vector<int>{prototype.getPopulationSize()} : grid.population_size;
+
+        for (int size : population_size) {
+            for (float sbx : eta_sbx) {
+                for (float m : eta_m) {
+                    for (float probability : mutation_probability) {
+                        for (int repetition = 0; repetition < options.repetitions; ++repetition) {
+                            cells_.push_back({sbx, m, probability, size, repetition});
+                        }
+                    }
+                }
+            }
+        }
+
+        // 初期個体群は個体群サイズごとに1回だけ生成し，全セルで共有する
+        for (int size : population_size) {
+            if (initial_populations.count(size) > 0) continue;
+            TwoTransProblem generator(prototype);
+            generator.setSeed(options.base_seed);
+            generator.setPopulationSize(size);
+            generator.generateFirstParents();
+            generator.evaluatePopulation(generator.parents);
+            generator.sortPopulation(generator.parents);
+            initial_populations[size] = std::make_shared<const std::vector<nsgaii::Individual>>(generator.parents);
+        }
+    }
+
+    const std::vector<SweepResult>& ParameterSweep::run() {
+        results.assign(cells_.size(), SweepResult{});
+
+        int thread_count = options.thread_count;
+        if (thread_count <= 0) {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::min<int>(thread_count, cells_.size());
+
+        // 各スレッドが未実行のセルを順に取り出して実行する
+        std::atomic<size_t> next_cell(0);
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count);
+        for (int i = 0; i < thread_count; ++i) {
+            workers.emplace_back([&]() {
+                size_t cell_index;
+                while ((cell_index = next_cell.fetch_add(1)) < cells_.size()) {
+                    results[cell_index] = runCell(cell_index);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        return results;
+    }
+
+    SweepResult ParameterSweep::runCell(size_t cell_index) const {
+        auto start = std::chrono::steady_clock::now();
+        const SweepCell& cell = cells_[cell_index];
+
+        TwoTransProblem nsgaii(prototype);
+        nsgaii.setPopulationSize(cell.population_size);
+        nsgaii.setEtaSBX(cell.eta_sbx);
+        nsgaii.setEtaM(cell.eta_m);
+        nsgaii.setMutationProbability(cell.mutation_probability);
+        nsgaii.setSeed(options.base_seed + 7919u * static_cast<unsigned int>(cell_index + 1));
+        nsgaii.parents = *initial_populations.at(cell.population_size);
+        nsgaii.resetArchiveHypervolume();
+        double hyper_volume = nsgaii.updateArchiveHypervolume(nsgaii.parents);
+
+        nsgaii::ConvergenceMonitor monitor(config_file_path, cell.population_size);
+        int current_generation = 0;
+        while (current_generation < options.max_generation) {
+            nsgaii.generateChildren(options.random_selection);
+            nsgaii.evaluatePopulation(nsgaii.children);
+            nsgaii.generateCombinedPopulation();
+            nsgaii.sortPopulation(nsgaii.combind_population);
+            nsgaii.generateParents();
+            ++current_generation;
+
+            hyper_volume = nsgaii.updateArchiveHypervolume(nsgaii.children);
+            nsgaii::TerminationStatus status = monitor.update(nsgaii.parents, hyper_volume);
+            if (status == nsgaii::TerminationStatus::Restart) {
+                monitor.addEvaluations(nsgaii.partialRestart(monitor.eliteSize()));
+            } else if (status == nsgaii::TerminationStatus::Converged) {
+                break;
+            }
+        }
+
+        SweepResult result;
+        result.cell = cell;
+        result.hypervolume = hyper_volume;
+        result.generations = current_generation;
+        result.evaluations = monitor.report(options.max_generation).evaluations;
+        result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    void ParameterSweep::writeResults(const std::string& csv_file_path) const {
+        std::ofstream csvFile(csv_file_path);
+        if (!csvFile) {
+            std::cerr << "ファイルを開けませんでした！" << std::endl;
+            return;
+        }
+
+        csvFile << "eta_sbx,eta_m,mutation_probability,population_size,repetition,hypervolume,generations,evaluations,elapsed_ms\n";
+        for (const auto& result : results) {
+            csvFile << result.cell.eta_sbx << "," << result.cell.eta_m << "," << result.cell.mutation_probability << ","
+                    << result.cell.population_size << "," << result.cell.repetition << ","
+                    << result.hypervolume << "," << result.generations << "," << result.evaluations << ","
+                    << result.elapsed_seconds * 1000.0 << "\n";
+        }
+    }
+} // namespace charge_schedule
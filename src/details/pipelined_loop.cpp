@@ -0,0 +1,157 @@
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "pipelined_loop.hpp"
+
+namespace charge_schedule
+{
+    namespace
+    {
+        double secondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    } // namespace
+
+    PipelinedLoop::PipelinedLoop(TwoTransProblem& problem, std::size_t queue_capacity)
+    : problem(problem), child_queue(queue_capacity), generation_done(false),
+      variation_items(0), variation_busy_seconds(0), evaluation_items(0), evaluation_busy_seconds(0), elapsed_seconds(0)
+    {
+        if (problem.getCrossoverMode() != nsgaii::CrossoverMode::PerPair) {
+            std::cerr << "パイプライン実行はcrossover_mode: per_pairのときのみ使えます" << std::endl;
+            throw std::invalid_argument("pipelined loop requires per_pair crossover_mode");
+        }
+        evaluation_thread = std::thread(&PipelinedLoop::evaluationLoop, this);
+    }
+
+    PipelinedLoop::~PipelinedLoop() {
+        child_queue.push({kStop, nsgaii::Individual(0)});
+        evaluation_thread.join();
+    }
+
+    void PipelinedLoop::step(bool random) {
+        auto step_start = std::chrono::steady_clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+            generation_done = false;
+        }
+        child_queue.push({kBegin, nsgaii::Individual(0)});
+
+        // 変異段
+        auto variation_start = std::chrono::steady_clock::now();
+        double push_wait_before = child_queue.pushWaitSeconds();
+        const std::vector<nsgaii::Individual>& parents = problem.parents;
+        const size_t child_count = problem.children.size();
+        problem.randomSelectionIndex(); // generateChildrenと同じ乱数列にするため，先頭の1回の選択を捨てる
+        for (size_t i = 0; i + 1 < child_count; i += 2) {
+            std::pair<int, int> selected = random ? problem.randomSelectionIndex() : problem.rankingSelectionIndex();
+            std::pair<nsgaii::Individual, nsgaii::Individual> child = problem.second_crossover(std::make_pair(parents[selected.first], parents[selected.second]));
+            child_queue.push({static_cast<int>(i), std::move(child.first)});
+            child_queue.push({static_cast<int>(i + 1), std::move(child.second)});
+        }
+        variation_busy_seconds += secondsSince(variation_start) - (child_queue.pushWaitSeconds() - push_wait_before);
+        variation_items += child_count;
+        child_queue.push({kEnd, nsgaii::Individual(0)});
+
+        // 評価段が前線を取り出すまで待つ
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            state_changed.wait(lock, [this] { return generation_done; });
+            if (evaluation_failure) {
+                std::exception_ptr failure = evaluation_failure;
+                evaluation_failure = nullptr;
+                std::rethrow_exception(failure);
+            }
+        }
+
+        problem.generateCombinedPopulation();
+        problem.sortPopulationByFronts(fronts, problem.combind_population);
+        problem.generateParents();
+        elapsed_seconds += secondsSince(step_start);
+    }
+
+    PipelinedLoop::Statistics PipelinedLoop::statistics() {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        auto occupancy = [this](double busy_seconds) {
+            return (elapsed_seconds > 0) ? busy_seconds / elapsed_seconds : 0.0;
+        };
+        Statistics result;
+        result.variation = {variation_items, variation_busy_seconds, child_queue.pushWaitSeconds(), occupancy(variation_busy_seconds)};
+        result.evaluation = {evaluation_items, evaluation_busy_seconds, child_queue.popWaitSeconds(), occupancy(evaluation_busy_seconds)};
+        result.queue_capacity = child_queue.capacity();
+        result.max_queue_depth = child_queue.maxDepth();
+        result.mean_queue_depth = child_queue.meanDepth();
+        result.elapsed_seconds = elapsed_seconds;
+        return result;
+    }
+
+    void PipelinedLoop::printStatistics(std::ostream& os) {
+        Statistics s = statistics();
+        auto printStage = [&os](const char* name, const StageStatistics& stage) {
+            os << "  " << name << ": items " << stage.items << ", busy " << stage.busy_seconds
+               << " s, wait " << stage.wait_seconds << " s, occupancy " << stage.occupancy << std::endl;
+        };
+        os << "--- pipeline ---" << std::endl;
+        os << "  elapsed: " << s.elapsed_seconds << " s" << std::endl;
+        printStage("variation", s.variation);
+        printStage("evaluation", s.evaluation);
+        os << "  queue: capacity " << s.queue_capacity << ", max depth " << s.max_queue_depth
+           << ", mean depth " << s.mean_queue_depth << std::endl;
+    }
+
+    void PipelinedLoop::evaluationLoop() {
+        double busy_seconds = 0;
+        std::size_t items = 0;
+        while (true) {
+            ChildItem item = child_queue.pop();
+            if (item.index == kStop) {
+                return;
+            }
+            auto start = std::chrono::steady_clock::now();
+            if (item.index == kEnd) {
+                try {
+                    fronts = dominance.fronts();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state_mutex);
+                    evaluation_failure = std::current_exception();
+                }
+                busy_seconds += secondsSince(start);
+                {
+                    std::lock_guard<std::mutex> lock(state_mutex);
+                    evaluation_busy_seconds += busy_seconds;
+                    evaluation_items += items;
+                    generation_done = true;
+                }
+                state_changed.notify_all();
+                busy_seconds = 0;
+                items = 0;
+                continue;
+            }
+
+            try {
+                if (item.index == kBegin) {
+                    // 親同士の支配関係は子が届く前に数えておく（親の添字がcombind_populationの先頭に対応）
+                    dominance.clear();
+                    dominance.reserve(problem.parents.size() + problem.children.size());
+                    for (const nsgaii::Individual& parent : problem.parents) {
+                        dominance.add(parent.f1, parent.f2);
+                    }
+                } else {
+                    // 変異段は1スレッドで添字順に送るので，到着順がcombind_populationでの子の並びと一致する
+                    problem.calucObjectiveFunction(item.individual);
+                    dominance.add(item.individual.f1, item.individual.f2);
+                    problem.children[item.index] = std::move(item.individual);
+                    ++items;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                if (!evaluation_failure) {
+                    evaluation_failure = std::current_exception();
+                }
+            }
+            busy_seconds += secondsSince(start);
+        }
+    }
+} // namespace charge_schedule
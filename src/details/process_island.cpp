@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <new>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+
+#include "process_island.hpp"
+
+namespace charge_schedule
+{
+    static_assert(std::is_trivially_copyable<CompactGenotype>::value, "CompactGenotype must be trivially copyable");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory atomics must be lock free");
+    static_assert(std::atomic<int32_t>::is_always_lock_free, "shared memory atomics must be lock free");
+
+    namespace
+    {
+        constexpr size_t kCacheLine = 64;
+
+        size_t alignUp(size_t size) {
+            return (size + kCacheLine - 1) / kCacheLine * kCacheLine;
+        }
+    } // namespace
+
+    struct ProcessIslandSupervisor::IslandControl
+    {
+        std::atomic<uint64_t> heartbeat;        // 世代が進むたびに増加
+        std::atomic<int32_t> generation;        // 現在の世代
+        std::atomic<int32_t> finished;          // 最大世代まで到達したら1
+        std::atomic<int32_t> snapshot_buffer;   // 有効なスナップショットのバッファ番号（無い場合は-1）
+        std::atomic<int32_t> snapshot_generation;
+    };
+
+    struct ProcessIslandSupervisor::RingHeader
+    {
+        alignas(kCacheLine) std::atomic<uint64_t> head; // 消費者が次に読む位置
+        alignas(kCacheLine) std::atomic<uint64_t> tail; // 生産者が次に書く位置
+    };
+
+    ProcessIslandSupervisor::ProcessIslandSupervisor(const std::string& config_file_path, const ProcessIslandOptions& options)
+    : options(options),
+    prototype(config_file_path),
+    shm_base(nullptr),
+    shm_size(0),
+    total_restarts(0)
+    {
+        if (options.island_count <= 0) {
+            std::cerr << "island_countが無効です: " << options.island_count << std::endl;
+            throw std::invalid_argument("island_count is invalid");
+        }
+        if (options.migration_interval <= 0 || options.migration_size < 0) {
+            std::cerr << "移住設定が無効です: " << options.migration_interval << ", " << options.migration_size << std::endl;
+            throw std::invalid_argument("migration options are invalid");
+        }
+
+        population_size = prototype.parents.size();
+        ring_capacity = 1;
+        while (ring_capacity < static_cast<uint32_t>(4 * std::max(options.migration_size, 1))) {
+            ring_capacity <<= 1;
+        }
+
+        snapshot_individual_bytes = nsgaii::dispatchFixedCapacity(prototype.getMaxChargeNumber(), [](auto capacity) {
+            return sizeof(nsgaii::FixedIndividual<capacity>);
+        });
+
+        // 島ごとの領域: 制御ブロック，リングバッファ，2面のスナップショット
+        // 移住個体は圧縮遺伝子型（帯域を抑える），スナップショットは評価済みの固定長個体（復元で評価し直さない）
+        island_stride = alignUp(sizeof(IslandControl))
+                      + alignUp(sizeof(RingHeader))
+                      + alignUp(sizeof(CompactGenotype) * ring_capacity)
+                      + 2 * alignUp(snapshot_individual_bytes * population_size);
+        shm_size = island_stride * options.island_count;
+
+        shm_name = "/charge_schedule_islands_" + std::to_string(getpid());
+        int fd = shm_open(shm_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            std::cerr << "共有メモリを作成できませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("shm_open failed");
+        }
+        if (ftruncate(fd, shm_size) != 0) {
+            close(fd);
+            shm_unlink(shm_name.c_str());
+            std::cerr << "共有メモリのサイズを設定できませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("ftruncate failed");
+        }
+        shm_base = mmap(nullptr, shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        // 子プロセスはforkでマップを引き継ぐため名前は不要．異常終了時に残らないよう直ちに削除する
+        shm_unlink(shm_name.c_str());
+        if (shm_base == MAP_FAILED) {
+            shm_base = nullptr;
+            std::cerr << "共有メモリをマップできませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("mmap failed");
+        }
+
+        for (int i = 0; i < options.island_count; ++i) {
+            IslandControl* ctl = new (control(i)) IslandControl;
+            ctl->heartbeat.store(0);
+            ctl->generation.store(0);
+            ctl->finished.store(0);
+            ctl->snapshot_buffer.store(-1);
+            ctl->snapshot_generation.store(-1);
+            RingHeader* header = new (ring(i)) RingHeader;
+            header->head.store(0);
+            header->tail.store(0);
+        }
+        pids.assign(options.island_count, -1);
+        restarts.assign(options.island_count, 0);
+    }
+
+    ProcessIslandSupervisor::~ProcessIslandSupervisor() {
+        for (pid_t pid : pids) {
+            if (pid > 0) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+        }
+        if (shm_base != nullptr) {
+            munmap(shm_base, shm_size);
+        }
+    }
+
+    ProcessIslandSupervisor::IslandControl* ProcessIslandSupervisor::control(int island_id) {
+        char* base = static_cast<char*>(shm_base) + island_stride * island_id;
+        return reinterpret_cast<IslandControl*>(base);
+    }
+
+    ProcessIslandSupervisor::RingHeader* ProcessIslandSupervisor::ring(int island_id) {
+        char* base = reinterpret_cast<char*>(control(island_id)) + alignUp(sizeof(IslandControl));
+        return reinterpret_cast<RingHeader*>(base);
+    }
+
+    CompactGenotype* ProcessIslandSupervisor::ringSlots(int island_id) {
+        char* base = reinterpret_cast<char*>(ring(island_id)) + alignUp(sizeof(RingHeader));
+        return reinterpret_cast<CompactGenotype*>(base);
+    }
+
+    void* ProcessIslandSupervisor::snapshotBuffer(int island_id, int buffer) {
+        char* base = reinterpret_cast<char*>(ringSlots(island_id)) + alignUp(sizeof(CompactGenotype) * ring_capacity);
+        return base + buffer * alignUp(snapshot_individual_bytes * population_size);
+    }
+
+    void ProcessIslandSupervisor::run() {
+        using clock = std::chrono::steady_clock;
+        int island_count = options.island_count;
+        std::vector<bool> done(island_count, false);
+        std::vector<uint64_t> last_heartbeat(island_count, 0);
+        std::vector<clock::time_point> last_progress(island_count, clock::now());
+
+        for (int i = 0; i < island_count; ++i) {
+            spawnIsland(i);
+        }
+
+        int remaining = island_count;
+        while (remaining > 0) {
+            for (int i = 0; i < island_count; ++i) {
+                if (done[i]) continue;
+
+                bool restart = false;
+                int status = 0;
+                pid_t result = waitpid(pids[i], &status, WNOHANG);
+                if (result == pids[i]) {
+                    pids[i] = -1;
+                    if (control(i)->finished.load(std::memory_order_acquire) == 1) {
+                        done[i] = true;
+                        --remaining;
+                        continue;
+                    }
+                    std::cerr << "島" << i << "が異常終了しました (status " << status << ")" << std::endl;
+                    restart = true;
+                } else {
+                    uint64_t heartbeat = control(i)->heartbeat.load(std::memory_order_relaxed);
+                    if (heartbeat != last_heartbeat[i]) {
+                        last_heartbeat[i] = heartbeat;
+                        last_progress[i] = clock::now();
+                    } else if (std::chrono::duration<double>(clock::now() - last_progress[i]).count() > options.stall_timeout) {
+                        // 修復処理などで停止した島を強制終了
+                        std::cerr << "島" << i << "が停止しています．強制終了します" << std::endl;
+                        kill(pids[i], SIGKILL);
+                        waitpid(pids[i], nullptr, 0);
+                        pids[i] = -1;
+                        restart = true;
+                    }
+                }
+
+                if (restart) {
+                    if (restarts[i] >= options.max_restarts) {
+                        std::cerr << "島" << i << "の再起動回数が上限に達しました" << std::endl;
+                        done[i] = true;
+                        --remaining;
+                        continue;
+                    }
+                    ++restarts[i];
+                    ++total_restarts;
+                    spawnIsland(i);
+                    last_progress[i] = clock::now();
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    void ProcessIslandSupervisor::spawnIsland(int island_id) {
+        std::cout.flush();
+        std::cerr.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "プロセスを起動できませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("fork failed");
+        }
+        if (pid == 0) {
+            runIsland(island_id);
+        }
+        pids[island_id] = pid;
+    }
+
+    void ProcessIslandSupervisor::runIsland(int island_id) {
+        int exit_code = 0;
+        try {
+            // 再起動時は同じ乱数列で同じ箇所に陥らないようシードを変える
+            TwoTransProblem& island = prototype;
+            island.setSeed(options.base_seed + 7919u * island_id + 104729u * restarts[island_id]);
+            IslandControl* ctl = control(island_id);
+
+            int generation = readSnapshot(island_id, island.parents);
+            if (generation < 0) {
+                island.setInitialThreads(1); // 島ごとに別プロセスで並列に走るため逐次に生成する
+                island.generateFirstParents();
+                island.evaluatePopulation(island.parents);
+                island.sortPopulation(island.parents);
+                generation = 0;
+                writeSnapshot(island_id, generation, island.parents);
+            }
+
+            while (generation < options.max_generation) {
+                island.generateChildren(options.random_selection);
+                island.evaluatePopulation(island.children);
+                island.generateCombinedPopulation();
+                island.sortPopulation(island.combind_population);
+                island.generateParents();
+                ++generation;
+
+                if (generation % options.migration_interval == 0) {
+                    if (options.island_count > 1) {
+                        int destination = (island_id + 1) % options.island_count;
+                        int sent = 0;
+                        for (const auto& individual : island.parents) {
+                            if (sent >= options.migration_size || individual.fronts_count != 0) break;
+                            if (!pushMigrant(destination, individual)) break;
+                            ++sent;
+                        }
+
+                        nsgaii::Individual migrant(0);
+                        size_t received = 0;
+                        while (received < island.parents.size() && popMigrant(island_id, migrant)) {
+                            island.parents[island.parents.size() - 1 - received] = migrant;
+                            ++received;
+                        }
+                        if (received > 0) {
+                            island.sortPopulation(island.parents);
+                        }
+                    }
+                    writeSnapshot(island_id, generation, island.parents);
+                }
+
+                ctl->generation.store(generation, std::memory_order_relaxed);
+                ctl->heartbeat.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            writeSnapshot(island_id, generation, island.parents);
+            ctl->finished.store(1, std::memory_order_release);
+        } catch (const std::exception& e) {
+            std::cerr << "島" << island_id << ": " << e.what() << std::endl;
+            exit_code = 1;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(exit_code);
+    }
+
+    bool ProcessIslandSupervisor::pushMigrant(int destination, const nsgaii::Individual& individual) {
+        RingHeader* header = ring(destination);
+        uint64_t current_tail = header->tail.load(std::memory_order_relaxed);
+        if (current_tail - header->head.load(std::memory_order_acquire) >= ring_capacity) {
+            return false;
+        }
+        encodeGenotype(individual, ringSlots(destination)[current_tail % ring_capacity]);
+        header->tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool ProcessIslandSupervisor::popMigrant(int island_id, nsgaii::Individual& individual) {
+        RingHeader* header = ring(island_id);
+        uint64_t current_head = header->head.load(std::memory_order_relaxed);
+        if (current_head == header->tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        prototype.decodeGenotype(ringSlots(island_id)[current_head % ring_capacity], individual);
+        header->head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void ProcessIslandSupervisor::writeSnapshot(int island_id, int generation, const std::vector<nsgaii::Individual>& population) {
+        // 書き込み途中で異常終了しても前回のスナップショットが残るよう，使用していない面へ書く
+        IslandControl* ctl = control(island_id);
+        int buffer = (ctl->snapshot_buffer.load(std::memory_order_relaxed) == 0) ? 1 : 0;
+        void* buffer_base = snapshotBuffer(island_id, buffer);
+        nsgaii::dispatchFixedCapacity(prototype.getMaxChargeNumber(), [&](auto capacity) {
+            nsgaii::FixedIndividual<capacity>* snapshot = static_cast<nsgaii::FixedIndividual<capacity>*>(buffer_base);
+            for (int i = 0; i < population_size; ++i) {
+                nsgaii::toFixed(population[i], snapshot[i]);
+            }
+        });
+        ctl->snapshot_generation.store(generation, std::memory_order_relaxed);
+        ctl->snapshot_buffer.store(buffer, std::memory_order_release);
+    }
+
+    int ProcessIslandSupervisor::readSnapshot(int island_id, std::vector<nsgaii::Individual>& population) {
+        IslandControl* ctl = control(island_id);
+        int buffer = ctl->snapshot_buffer.load(std::memory_order_acquire);
+        if (buffer < 0) {
+            return -1;
+        }
+        // 評価値・派生値ごと保存しているので，復号・評価をやり直さずにそのまま戻す
+        const void* buffer_base = snapshotBuffer(island_id, buffer);
+        population.resize(population_size, nsgaii::Individual(0));
+        nsgaii::dispatchFixedCapacity(prototype.getMaxChargeNumber(), [&](auto capacity) {
+            const nsgaii::FixedIndividual<capacity>* snapshot = static_cast<const nsgaii::FixedIndividual<capacity>*>(buffer_base);
+            for (int i = 0; i < population_size; ++i) {
+                nsgaii::fromFixed(snapshot[i], population[i]);
+            }
+        });
+        // 書き込んだ個体群はソート済みだが，選択に使う順位は読み出し側で並べ直して求める
+        prototype.sortPopulation(population);
+        return ctl->snapshot_generation.load(std::memory_order_relaxed);
+    }
+
+    std::vector<nsgaii::Individual> ProcessIslandSupervisor::mergedFront() {
+        std::vector<nsgaii::Individual> merged;
+        std::vector<nsgaii::Individual> population;
+        for (int i = 0; i < options.island_count; ++i) {
+            if (readSnapshot(i, population) >= 0) {
+                merged.insert(merged.end(), population.begin(), population.end());
+            }
+        }
+        prototype.sortPopulation(merged);
+
+        std::vector<nsgaii::Individual> front;
+        for (const auto& individual : merged) {
+            if (individual.fronts_count != 0) break;
+            front.push_back(individual);
+        }
+        return front;
+    }
+
+    double ProcessIslandSupervisor::mergedHypervolume() {
+        std::pair<float, float> reference = prototype.hypervolumeReference();
+        return prototype.calculateHypervolume(mergedFront(), reference.first, reference.second);
+    }
+} // namespace charge_schedule
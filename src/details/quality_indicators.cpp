@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "quality_indicators.hpp"
+
+namespace nsgaii {
+   std::vector<ObjectivePoint> nondominatedPoints(const std::vector<Individual>& population) {
+      std::vector<ObjectivePoint> points;
+      points.reserve(population.size());
+      for (const auto& individual : population) {
+         if (individual.penalty == 0) {
+            points.emplace_back(individual.f1, individual.f2);
+         }
+      }
+      return nondominatedPoints(std::move(points));
+   }
+
+   std::vector<ObjectivePoint> nondominatedPoints(std::vector<ObjectivePoint> points) {
+      // f1昇順に並べ，それまでの最小f2より小さい点のみを残す
+      std::sort(points.begin(), points.end());
+      std::vector<ObjectivePoint> front;
+      float best_f2 = std::numeric_limits<float>::infinity();
+      for (const auto& point : points) {
+         if (point.second < best_f2) {
+            front.push_back(point);
+            best_f2 = point.second;
+         }
+      }
+      return front;
+   }
+
+   double hypervolume(const std::vector<ObjectivePoint>& front, float f1_reference, float f2_reference) {
+      HypervolumeTracker tracker(f1_reference, f2_reference);
+      for (const auto& point : front) {
+         tracker.insert(point.first, point.second);
+      }
+      return tracker.hypervolume();
+   }
+
+   double invertedGenerationalDistance(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front) {
+      if (reference_front.empty()) {
+         return 0.0;
+      }
+      if (front.empty()) {
+         return std::numeric_limits<double>::infinity();
+      }
+      double total = 0.0;
+      for (const auto& reference : reference_front) {
+         double nearest = std::numeric_limits<double>::infinity();
+         for (const auto& point : front) {
+            double d1 = point.first - reference.first;
+            double d2 = point.second - reference.second;
+            nearest = std::min(nearest, d1 * d1 + d2 * d2);
+         }
+         total += std::sqrt(nearest);
+      }
+      return total / reference_front.size();
+   }
+
+   double spread(const std::vector<ObjectivePoint>& front, const std::vector<ObjectivePoint>& reference_front) {
+      if (front.size() < 2 || reference_front.empty()) {
+         return 1.0;
+      }
+      auto distance = [](const ObjectivePoint& a, const ObjectivePoint& b) {
+         double d1 = a.first - b.first;
+         double d2 = a.second - b.second;
+         return std::sqrt(d1 * d1 + d2 * d2);
+      };
+
+      // frontはf1昇順の非支配点を想定．端点は参照フロントの両端と比較する
+      std::vector<double> gaps;
+      gaps.reserve(front.size() - 1);
+      for (size_t i = 0; i + 1 < front.size(); ++i) {
+         gaps.push_back(distance(front[i], front[i + 1]));
+      }
+      double mean_gap = 0.0;
+      for (double gap : gaps) {
+         mean_gap += gap;
+      }
+      mean_gap /= gaps.size();
+
+      double d_first = distance(front.front(), reference_front.front());
+      double d_last = distance(front.back(), reference_front.back());
+      double deviation = 0.0;
+      for (double gap : gaps) {
+         deviation += std::abs(gap - mean_gap);
+      }
+      double denominator = d_first + d_last + gaps.size() * mean_gap;
+      return (denominator > 0) ? (d_first + d_last + deviation) / denominator : 0.0;
+   }
+
+   SummaryStatistics summarize(std::vector<double> values) {
+      SummaryStatistics statistics{0.0, 0.0, 0.0, static_cast<int>(values.size())};
+      if (values.empty()) {
+         return statistics;
+      }
+      std::sort(values.begin(), values.end());
+      size_t n = values.size();
+      statistics.median = (n % 2 == 1) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+
+      // 二項分布の正規近似による順序統計量の順位（1始まり）
+      double half_width = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+      long lower_rank = static_cast<long>(std::floor(n / 2.0 - half_width));
+      long upper_rank = static_cast<long>(std::ceil(1 + n / 2.0 + half_width));
+      lower_rank = std::max(1L, lower_rank);
+      upper_rank = std::min(static_cast<long>(n), upper_rank);
+      statistics.lower = values[lower_rank - 1];
+      statistics.upper = values[upper_rank - 1];
+      return statistics;
+   }
+} // namespace nsgaii
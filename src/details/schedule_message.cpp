@@ -0,0 +1,132 @@
+#include <iostream>
+#include <stdexcept>
+
+#include "front_index.hpp"
+#include "schedule_message.hpp"
+
+namespace charge_schedule
+{
+    namespace
+    {
+        // IndividualとDecodedScheduleに共通する書き込み（配列はcharge_count個）
+        struct ScheduleFields
+        {
+            float f1;
+            float f2;
+            int first_soc;
+            int charge_count;
+            const float* time;
+            const int* soc;
+            const int* charging_position;
+            const int* return_position;
+            const int* cycle_count;
+            const std::array<float, 4>* span;
+        };
+
+        size_t encodeFields(const ScheduleFields& fields, uint32_t robot_id, uint32_t sequence, void* buffer, size_t capacity) {
+            if (fields.charge_count < 0 || fields.charge_count > schedule_message::kMaxChargeCount) {
+                std::cerr << "充電回数が無効です: " << fields.charge_count << std::endl;
+                throw std::out_of_range("charge_count is out of range");
+            }
+            const size_t total_bytes = scheduleMessageSize(fields.charge_count);
+            if (buffer == nullptr || capacity < total_bytes) {
+                std::cerr << "書き込み先の大きさが足りません: " << capacity << " < " << total_bytes << std::endl;
+                throw std::invalid_argument("buffer is too small");
+            }
+
+            ScheduleMessageHeader* header = static_cast<ScheduleMessageHeader*>(buffer);
+            header->magic = schedule_message::kMagic;
+            header->version = schedule_message::kVersion;
+            header->header_bytes = sizeof(ScheduleMessageHeader);
+            header->total_bytes = static_cast<uint32_t>(total_bytes);
+            header->record_bytes = sizeof(ScheduleCharge);
+            header->charge_count = static_cast<uint16_t>(fields.charge_count);
+            header->robot_id = robot_id;
+            header->sequence = sequence;
+            header->f1 = fields.f1;
+            header->f2 = fields.f2;
+            header->first_soc = static_cast<uint8_t>(fields.first_soc);
+            header->reserved[0] = header->reserved[1] = header->reserved[2] = 0;
+
+            ScheduleCharge* records = reinterpret_cast<ScheduleCharge*>(header + 1);
+            for (int i = 0; i < fields.charge_count; ++i) {
+                const std::array<float, 4>& span = fields.span[i];
+                if (fields.soc[i] < 0 || fields.soc[i] > 255 || fields.cycle_count[i] < 0 || fields.cycle_count[i] > 0xffff) {
+                    std::cerr << "遺伝子が範囲外です: soc " << fields.soc[i] << ", cycle " << fields.cycle_count[i] << std::endl;
+                    throw std::out_of_range("gene is out of range");
+                }
+                ScheduleCharge& record = records[i];
+                record.departure = fields.time[i];
+                record.return_time = fields.time[i] + span[1] + span[2] + span[3];
+                record.span[0] = span[0];
+                record.span[1] = span[1];
+                record.span[2] = span[2];
+                record.span[3] = span[3];
+                record.cycle_count = static_cast<uint16_t>(fields.cycle_count[i]);
+                record.target_soc = static_cast<uint8_t>(fields.soc[i]);
+                record.charging_position = static_cast<uint8_t>(fields.charging_position[i]);
+                record.return_position = static_cast<uint8_t>(fields.return_position[i]);
+                record.reserved[0] = record.reserved[1] = record.reserved[2] = 0;
+            }
+            return total_bytes;
+        }
+
+        ScheduleFields fieldsOf(const nsgaii::Individual& individual) {
+            return {individual.f1, individual.f2, individual.first_soc, individual.charging_number,
+                    individual.time_chromosome.data(), individual.soc_chromosome.data(), individual.charging_position.data(),
+                    individual.return_position.data(), individual.cycle_count.data(), individual.T_span.data()};
+        }
+
+        ScheduleFields fieldsOf(const DecodedSchedule& schedule) {
+            return {schedule.f1, schedule.f2, schedule.first_soc, schedule.charging_number,
+                    schedule.charge_time.data(), schedule.target_soc.data(), schedule.charging_position.data(),
+                    schedule.return_position.data(), schedule.cycle_count.data(), schedule.T_span.data()};
+        }
+    } // namespace
+
+    size_t encodeScheduleMessage(const nsgaii::Individual& individual, uint32_t robot_id, uint32_t sequence, void* buffer, size_t capacity) {
+        return encodeFields(fieldsOf(individual), robot_id, sequence, buffer, capacity);
+    }
+
+    size_t encodeScheduleMessage(const DecodedSchedule& schedule, uint32_t robot_id, uint32_t sequence, void* buffer, size_t capacity) {
+        return encodeFields(fieldsOf(schedule), robot_id, sequence, buffer, capacity);
+    }
+
+    void encodeScheduleMessage(const nsgaii::Individual& individual, uint32_t robot_id, uint32_t sequence, std::vector<uint8_t>& buffer) {
+        buffer.resize(scheduleMessageSize(individual.charging_number));
+        encodeScheduleMessage(individual, robot_id, sequence, buffer.data(), buffer.size());
+    }
+
+    void encodeScheduleMessage(const DecodedSchedule& schedule, uint32_t robot_id, uint32_t sequence, std::vector<uint8_t>& buffer) {
+        buffer.resize(scheduleMessageSize(schedule.charging_number));
+        encodeScheduleMessage(schedule, robot_id, sequence, buffer.data(), buffer.size());
+    }
+
+    bool decodeScheduleMessage(const void* data, size_t size, DecodedSchedule& schedule) {
+        ScheduleMessageView view;
+        if (!view.reset(data, size)) {
+            return false;
+        }
+        const int n = view.chargeCount();
+        schedule.f1 = view.f1();
+        schedule.f2 = view.f2();
+        schedule.first_soc = view.firstSoc();
+        schedule.charging_number = n;
+        schedule.charge_time.resize(n);
+        schedule.target_soc.resize(n);
+        schedule.charging_position.resize(n);
+        schedule.return_position.resize(n);
+        schedule.cycle_count.resize(n);
+        schedule.T_span.resize(n);
+        for (int i = 0; i < n; ++i) {
+            const ScheduleCharge& record = view.charge(i);
+            schedule.charge_time[i] = record.departure;
+            schedule.target_soc[i] = record.target_soc;
+            schedule.charging_position[i] = record.charging_position;
+            schedule.return_position[i] = record.return_position;
+            schedule.cycle_count[i] = record.cycle_count;
+            schedule.T_span[i] = {record.span[0], record.span[1], record.span[2], record.span[3]};
+        }
+        return true;
+    }
+} // namespace charge_schedule
@@ -0,0 +1,164 @@
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "schedule_protocol.hpp"
+
+namespace charge_schedule
+{
+    namespace protocol
+    {
+        namespace
+        {
+            template <typename T>
+            void append(std::vector<uint8_t>& payload, const T& value) {
+                const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+                payload.insert(payload.end(), bytes, bytes + sizeof(T));
+            }
+
+            void appendBytes(std::vector<uint8_t>& payload, const void* data, size_t size) {
+                const uint8_t* bytes = static_cast<const uint8_t*>(data);
+                payload.insert(payload.end(), bytes, bytes + size);
+            }
+
+            // payloadのoffsetから読み進める（不足していればfalse）
+            bool readBytes(const std::vector<uint8_t>& payload, size_t& offset, void* data, size_t size) {
+                if (payload.size() - offset < size) {
+                    return false;
+                }
+                std::memcpy(data, payload.data() + offset, size);
+                offset += size;
+                return true;
+            }
+
+            bool readFloats(const std::vector<uint8_t>& payload, size_t& offset, std::vector<float>& values, size_t count) {
+                values.resize(count);
+                return readBytes(payload, offset, values.data(), sizeof(float) * count);
+            }
+
+            bool checkHeader(const FrameHeader& header, uint32_t magic) {
+                return header.magic == magic && header.version == kVersion && header.payload_bytes <= kMaxPayloadBytes;
+            }
+        } // namespace
+
+        void appendFrame(std::vector<uint8_t>& buffer, uint32_t magic, MessageType type, const std::vector<uint8_t>& payload) {
+            buffer.reserve(buffer.size() + sizeof(FrameHeader) + payload.size());
+            append(buffer, FrameHeader{magic, kVersion, static_cast<uint16_t>(type), static_cast<uint32_t>(payload.size())});
+            buffer.insert(buffer.end(), payload.begin(), payload.end());
+        }
+
+        bool writeFrame(int fd, uint32_t magic, MessageType type, const std::vector<uint8_t>& payload) {
+            std::vector<uint8_t> frame;
+            appendFrame(frame, magic, type, payload);
+
+            size_t written = 0;
+            while (written < frame.size()) {
+                ssize_t result = ::send(fd, frame.data() + written, frame.size() - written, MSG_NOSIGNAL);
+                if (result < 0) {
+                    if (errno == EINTR) continue;
+                    return false;
+                }
+                written += result;
+            }
+            return true;
+        }
+
+        bool readFrame(int fd, uint32_t magic, FrameHeader& header, std::vector<uint8_t>& payload) {
+            auto readFull = [fd](void* data, size_t size) {
+                uint8_t* bytes = static_cast<uint8_t*>(data);
+                size_t received = 0;
+                while (received < size) {
+                    ssize_t result = ::read(fd, bytes + received, size - received);
+                    if (result < 0 && errno == EINTR) continue;
+                    if (result <= 0) return false;
+                    received += result;
+                }
+                return true;
+            };
+            if (!readFull(&header, sizeof(header)) || !checkHeader(header, magic)) {
+                return false;
+            }
+            payload.resize(header.payload_bytes);
+            return readFull(payload.data(), payload.size());
+        }
+
+        bool extractFrame(std::vector<uint8_t>& buffer, uint32_t magic, FrameHeader& header, std::vector<uint8_t>& payload) {
+            if (buffer.size() < sizeof(FrameHeader)) {
+                return false;
+            }
+            std::memcpy(&header, buffer.data(), sizeof(header));
+            if (!checkHeader(header, magic)) {
+                std::cerr << "フレームのヘッダが無効です: magic " << header.magic << ", version " << header.version << std::endl;
+                throw std::runtime_error("frame header is invalid");
+            }
+            const size_t frame_bytes = sizeof(FrameHeader) + header.payload_bytes;
+            if (buffer.size() < frame_bytes) {
+                return false;
+            }
+            payload.assign(buffer.begin() + sizeof(FrameHeader), buffer.begin() + frame_bytes);
+            buffer.erase(buffer.begin(), buffer.begin() + frame_bytes);
+            return true;
+        }
+
+        void encodeScheduleRequest(const ScheduleRequestData& request, std::vector<uint8_t>& payload) {
+            payload.clear();
+            append(payload, request.header);
+            const size_t count = request.header.visited_number;
+            for (const std::vector<float>* values : {&request.T_move, &request.T_standby, &request.T_cs,
+                                                     &request.E_move, &request.E_standby, &request.E_cs}) {
+                if (values->size() != count) {
+                    std::cerr << "訪問先ごとのパラメータの数がvisited_numberと一致しません: " << values->size() << std::endl;
+                    throw std::invalid_argument("per-site parameter size does not match visited_number");
+                }
+                appendBytes(payload, values->data(), sizeof(float) * count);
+            }
+        }
+
+        bool decodeScheduleRequest(const std::vector<uint8_t>& payload, ScheduleRequestData& request) {
+            size_t offset = 0;
+            if (!readBytes(payload, offset, &request.header, sizeof(request.header))) {
+                return false;
+            }
+            const size_t count = request.header.visited_number;
+            return readFloats(payload, offset, request.T_move, count)
+                && readFloats(payload, offset, request.T_standby, count)
+                && readFloats(payload, offset, request.T_cs, count)
+                && readFloats(payload, offset, request.E_move, count)
+                && readFloats(payload, offset, request.E_standby, count)
+                && readFloats(payload, offset, request.E_cs, count)
+                && offset == payload.size();
+        }
+
+        void encodeScheduleReply(const ScheduleReply& reply, const std::vector<FrontEntry>& front, std::vector<uint8_t>& payload) {
+            payload.clear();
+            append(payload, reply);
+            for (const FrontEntry& entry : front) {
+                append(payload, entry.f1);
+                append(payload, entry.f2);
+                appendBytes(payload, &entry.genotype, encodedSize(entry.genotype));
+            }
+        }
+
+        bool decodeScheduleReply(const std::vector<uint8_t>& payload, ScheduleReply& reply, std::vector<FrontEntry>& front) {
+            size_t offset = 0;
+            if (!readBytes(payload, offset, &reply, sizeof(reply))) {
+                return false;
+            }
+            front.resize(reply.front_size);
+            for (FrontEntry& entry : front) {
+                const size_t header_bytes = offsetof(CompactGenotype, genes);
+                if (!readBytes(payload, offset, &entry.f1, sizeof(float)) || !readBytes(payload, offset, &entry.f2, sizeof(float))
+                    || !readBytes(payload, offset, &entry.genotype, header_bytes)
+                    || entry.genotype.charging_number > kCompactMaxCharge
+                    || !readBytes(payload, offset, entry.genotype.genes, sizeof(uint16_t) * entry.genotype.charging_number)) {
+                    return false;
+                }
+            }
+            return offset == payload.size();
+        }
+    } // namespace protocol
+} // namespace charge_schedule
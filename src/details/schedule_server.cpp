@@ -0,0 +1,454 @@
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "schedule_server.hpp"
+
+namespace charge_schedule
+{
+    namespace
+    {
+        FleetOptions fleetOptions(const ServerOptions& options) {
+            FleetOptions fleet;
+            fleet.thread_count = options.thread_count;
+            fleet.max_generation = options.default_generations;
+            return fleet;
+        }
+
+        double secondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        bool sameSites(const nsgaii::ScheduleParameters& a, const nsgaii::ScheduleParameters& b) {
+            return a.visited_number == b.visited_number && a.T_move == b.T_move && a.T_standby == b.T_standby
+                && a.T_cs == b.T_cs && a.E_move == b.E_move && a.E_standby == b.E_standby && a.E_cs == b.E_cs;
+        }
+
+        // 要求の訪問先ごとのパラメータを検証する（visited_number = 0はサーバのYAMLの値を使う）
+        // TwoTransProblemは2地点を前提とし，E_cycleが正でないと充電サイクル数の計算が発散する
+        bool validSites(const protocol::ScheduleRequestData& request) {
+            if (request.header.visited_number == 0) {
+                return true;
+            }
+            if (request.header.visited_number != 2) {
+                return false;
+            }
+            for (const std::vector<float>* values : {&request.T_move, &request.T_standby, &request.T_cs,
+                                                     &request.E_move, &request.E_standby, &request.E_cs}) {
+                for (float value : *values) {
+                    if (!std::isfinite(value) || value <= 0) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    ScheduleServer::ScheduleServer(const std::string& config_file_path, const ServerOptions& options)
+    : options(options), base_parameters(nsgaii::loadScheduleParameters(config_file_path)),
+      optimizer(fleetOptions(options)), listen_fd(-1), stopping(false), use_counter(0),
+      latency_next(0), requests(0), rejected(0), warm_starts(0), batches(0), batched_requests(0), optimise_seconds(0)
+    {
+        if (options.batch_window_ms < 0 || options.max_batch <= 0 || options.default_generations < 0 || options.latency_samples == 0) {
+            std::cerr << "サーバの設定が無効です: " << options.batch_window_ms << ", " << options.max_batch << std::endl;
+            throw std::invalid_argument("server options are invalid");
+        }
+        base_parameters.worker_threads = 1; // 並列化はFleetOptimizerの共有プールで行う
+        base_parameters.initial_threads = 1;
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (options.socket_path.empty() || options.socket_path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "ソケットのパスが無効です: " << options.socket_path << std::endl;
+            throw std::invalid_argument("socket_path is invalid");
+        }
+        std::strncpy(address.sun_path, options.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd < 0) {
+            std::cerr << "ソケットを作成できませんでした: " << std::strerror(errno) << std::endl;
+            throw std::runtime_error("socket failed");
+        }
+        ::unlink(options.socket_path.c_str());
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listen_fd, 64) < 0) {
+            std::cerr << "ソケットを待ち受けにできませんでした: " << std::strerror(errno) << std::endl;
+            ::close(listen_fd);
+            throw std::runtime_error("bind/listen failed");
+        }
+        latencies.reserve(options.latency_samples);
+    }
+
+    ScheduleServer::~ScheduleServer() {
+        for (const Connection& connection : connections) {
+            ::close(connection.fd);
+        }
+        ::close(listen_fd);
+        ::unlink(options.socket_path.c_str());
+    }
+
+    void ScheduleServer::serve() {
+        std::vector<pollfd> fds;
+        while (!stopping) {
+            // 待ち時間は，まとめ中の要求があれば締め切りまで，無ければstopの確認のため100ms
+            int timeout = 100;
+            if (!pending.empty()) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(batch_deadline - Clock::now()).count();
+                timeout = static_cast<int>(std::max<long long>(0, std::min<long long>(timeout, remaining)));
+            }
+
+            fds.clear();
+            fds.push_back({listen_fd, POLLIN, 0});
+            for (const Connection& connection : connections) {
+                fds.push_back({connection.fd, static_cast<short>(connection.output.empty() ? POLLIN : POLLIN | POLLOUT), 0});
+            }
+            int ready = ::poll(fds.data(), fds.size(), timeout);
+            if (ready < 0 && errno != EINTR) {
+                std::cerr << "pollに失敗しました: " << std::strerror(errno) << std::endl;
+                throw std::runtime_error("poll failed");
+            }
+
+            if (ready > 0) {
+                for (size_t i = 1; i < fds.size(); ++i) {
+                    if (fds[i].revents == 0) continue;
+                    auto connection = std::find_if(connections.begin(), connections.end(),
+                        [&fds, i](const Connection& c) { return c.fd == fds[i].fd; });
+                    if ((fds[i].revents & POLLOUT) && !writeClient(*connection)) {
+                        connection->failed = true;
+                    }
+                    if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && !connection->failed && !readClient(*connection)) {
+                        connection->failed = true;
+                    }
+                }
+                if (fds[0].revents & POLLIN) {
+                    acceptClients();
+                }
+            }
+
+            if (!pending.empty() && (Clock::now() >= batch_deadline || pending.size() >= static_cast<size_t>(options.max_batch))) {
+                runBatch();
+            }
+
+            std::vector<int> closed;
+            for (const Connection& connection : connections) {
+                if (connection.failed) closed.push_back(connection.fd);
+            }
+            for (int fd : closed) {
+                closeConnection(fd);
+            }
+        }
+    }
+
+    void ScheduleServer::acceptClients() {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EINTR && errno != EAGAIN) {
+                std::cerr << "接続を受け付けられませんでした: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+            std::cerr << "接続をノンブロッキングにできませんでした: " << std::strerror(errno) << std::endl;
+            ::close(fd);
+            return;
+        }
+        connections.push_back({fd, {}, {}, false});
+    }
+
+    bool ScheduleServer::readClient(Connection& connection) {
+        uint8_t buffer[65536];
+        ssize_t received = ::read(connection.fd, buffer, sizeof(buffer));
+        if (received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        connection.input.insert(connection.input.end(), buffer, buffer + received);
+
+        protocol::FrameHeader header;
+        std::vector<uint8_t> payload;
+        try {
+            while (protocol::extractFrame(connection.input, protocol::kRequestMagic, header, payload)) {
+                handleFrame(connection.fd, header, payload);
+            }
+        } catch (const std::exception& e) {
+            ++rejected;
+            return false;
+        }
+        return true;
+    }
+
+    bool ScheduleServer::writeClient(Connection& connection) {
+        size_t written = 0;
+        while (written < connection.output.size()) {
+            ssize_t result = ::send(connection.fd, connection.output.data() + written, connection.output.size() - written, MSG_NOSIGNAL);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                return false;
+            }
+            written += result;
+        }
+        connection.output.erase(connection.output.begin(), connection.output.begin() + written);
+        return true;
+    }
+
+    void ScheduleServer::queueFrame(int fd, protocol::MessageType type, const std::vector<uint8_t>& payload) {
+        auto connection = std::find_if(connections.begin(), connections.end(), [fd](const Connection& c) { return c.fd == fd; });
+        if (connection == connections.end() || connection->failed) {
+            return;
+        }
+        // 送信待ちが空なら，その場で送れるだけ送る（残りはPOLLOUTで送る）
+        const bool idle = connection->output.empty();
+        protocol::appendFrame(connection->output, protocol::kReplyMagic, type, payload);
+        if (idle && !writeClient(*connection)) {
+            connection->failed = true;
+        } else if (connection->output.size() > options.max_output_bytes) {
+            std::cerr << "応答を読み出さないクライアントを切断します: " << connection->output.size() << " bytes" << std::endl;
+            connection->failed = true;
+        }
+    }
+
+    void ScheduleServer::handleFrame(int fd, const protocol::FrameHeader& header, const std::vector<uint8_t>& payload) {
+        const Clock::time_point received = Clock::now();
+        if (header.type == static_cast<uint16_t>(protocol::MessageType::Statistics)) {
+            std::string text = statisticsText();
+            queueFrame(fd, protocol::MessageType::Statistics, std::vector<uint8_t>(text.begin(), text.end()));
+            return;
+        }
+
+        PendingRequest request{fd, {}, received};
+        if (header.type != static_cast<uint16_t>(protocol::MessageType::Schedule) || !protocol::decodeScheduleRequest(payload, request.request)
+            || !validSites(request.request)) {
+            ++rejected;
+            protocol::ScheduleReply failure{};
+            failure.status = static_cast<uint16_t>(protocol::ReplyStatus::InvalidRequest);
+            reply(fd, failure, {}, received);
+            return;
+        }
+        if (pending.empty()) {
+            batch_deadline = received + std::chrono::milliseconds(options.batch_window_ms);
+        }
+        pending.push_back(std::move(request));
+    }
+
+    int ScheduleServer::requestedGenerations(const PendingRequest& request) const {
+        int requested = request.request.header.generations;
+        return requested > 0 ? requested : options.default_generations;
+    }
+
+    void ScheduleServer::runBatch() {
+        // 最初の要求と世代数が同じ要求だけをまとめる（FleetOptimizerは全ロボットを同じ世代数だけ進める）
+        // 同じロボットの要求は1回の最適化に1つだけ含め，残りは次のまとめに回す
+        const int generations = requestedGenerations(pending.front());
+        std::vector<PendingRequest> batch;
+        std::vector<PendingRequest> deferred;
+        for (PendingRequest& request : pending) {
+            bool duplicate = std::any_of(batch.begin(), batch.end(), [&request](const PendingRequest& other) {
+                return other.request.header.robot_id == request.request.header.robot_id;
+            });
+            bool other_generations = requestedGenerations(request) != generations;
+            ((duplicate || other_generations || batch.size() >= static_cast<size_t>(options.max_batch)) ? deferred : batch).push_back(std::move(request));
+        }
+        pending.swap(deferred);
+        // 持ち越した要求はすでにまとめの時間を待っているので，次の周回で最適化する
+        batch_deadline = Clock::now();
+
+        std::vector<TwoTransProblem*> problems;
+        std::vector<bool> warm;
+        std::vector<size_t> batch_index;   // problemsの各要素に対応するbatchの添字
+        std::vector<bool> warm_flags(batch.size(), false);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            TwoTransProblem* problem = nullptr;
+            try {
+                warm_flags[i] = prepareRobot(batch[i].request, problem);
+            } catch (const std::exception& e) {
+                ++rejected;
+                protocol::ScheduleReply failure{};
+                failure.robot_id = batch[i].request.header.robot_id;
+                failure.status = static_cast<uint16_t>(protocol::ReplyStatus::InvalidRequest);
+                reply(batch[i].fd, failure, {}, batch[i].received);
+                continue;
+            }
+            warm_starts += warm_flags[i] ? 1 : 0;
+            problems.push_back(problem);
+            warm.push_back(true); // prepareRobotで評価済みの親を用意している
+            batch_index.push_back(i);
+        }
+        if (problems.empty()) {
+            return;
+        }
+
+        auto start = Clock::now();
+        optimizer.setMaxGeneration(generations);
+        FleetResult result;
+        try {
+            result = optimizer.run(problems, warm);
+        } catch (const std::exception& e) {
+            std::cerr << "最適化に失敗しました: " << e.what() << std::endl;
+            for (size_t index : batch_index) {
+                protocol::ScheduleReply failure{};
+                failure.robot_id = batch[index].request.header.robot_id;
+                failure.status = static_cast<uint16_t>(protocol::ReplyStatus::Failed);
+                reply(batch[index].fd, failure, {}, batch[index].received);
+            }
+            return;
+        }
+        optimise_seconds += secondsSince(start);
+        ++batches;
+        batched_requests += problems.size();
+
+        for (size_t r = 0; r < problems.size(); ++r) {
+            const PendingRequest& request = batch[batch_index[r]];
+            std::vector<protocol::FrontEntry> front;
+            for (const nsgaii::Individual& individual : result.robots[r].front) {
+                protocol::FrontEntry entry;
+                entry.f1 = individual.f1;
+                entry.f2 = individual.f2;
+                try {
+                    encodeGenotype(individual, entry.genotype);
+                } catch (const std::out_of_range&) {
+                    continue;
+                }
+                front.push_back(entry);
+                if (front.size() == UINT16_MAX) break;
+            }
+            protocol::ScheduleReply ok{};
+            ok.robot_id = request.request.header.robot_id;
+            ok.status = static_cast<uint16_t>(protocol::ReplyStatus::Ok);
+            ok.front_size = static_cast<uint16_t>(front.size());
+            ok.warm = warm_flags[batch_index[r]] ? 1 : 0;
+            reply(request.fd, ok, front, request.received);
+        }
+        evictRobots();
+    }
+
+    bool ScheduleServer::prepareRobot(const protocol::ScheduleRequestData& request, TwoTransProblem*& problem) {
+        nsgaii::ScheduleParameters parameters = base_parameters;
+        if (request.header.visited_number > 0) {
+            parameters.visited_number = request.header.visited_number;
+            parameters.T_move = request.T_move;
+            parameters.T_standby = request.T_standby;
+            parameters.T_cs = request.T_cs;
+            parameters.E_move = request.E_move;
+            parameters.E_standby = request.E_standby;
+            parameters.E_cs = request.E_cs;
+        }
+        const int first_soc = request.header.first_soc;
+        if (first_soc <= 0 || first_soc > 100) {
+            std::cerr << "first_socが無効です: " << first_soc << std::endl;
+            throw std::invalid_argument("first_soc is invalid");
+        }
+
+        const uint32_t robot_id = request.header.robot_id;
+        auto found = robots.find(robot_id);
+        bool warm = false;
+        if (found != robots.end() && sameSites(found->second.parameters, parameters)) {
+            // 同じパラメータ: 保持している親を現在のSOCで復号し直す
+            warm = rebase(*found->second.problem, found->second.problem->parents, first_soc);
+        } else {
+            auto fresh = std::make_unique<TwoTransProblem>(parameters);
+            fresh->setSeed(robot_id);
+            if (found != robots.end()) {
+                // パラメータが変わった: 遺伝子型を新しいパラメータで復号して引き継ぐ
+                warm = rebase(*fresh, found->second.problem->parents, first_soc);
+            }
+            RobotEntry& entry = robots[robot_id];
+            entry.problem = std::move(fresh);
+            entry.parameters = parameters;
+            found = robots.find(robot_id);
+        }
+
+        TwoTransProblem& robot = *found->second.problem;
+        if (!warm) {
+            robot.generateFirstParents();
+            if (!rebase(robot, robot.parents, first_soc)) {
+                robot.evaluatePopulation(robot.parents);
+            }
+        }
+        found->second.last_used = ++use_counter;
+        problem = &robot;
+        return warm;
+    }
+
+    bool ScheduleServer::rebase(TwoTransProblem& problem, const std::vector<nsgaii::Individual>& source, int first_soc) {
+        if (source.size() != problem.parents.size()) {
+            return false;
+        }
+        CompactGenotype genotype;
+        for (size_t i = 0; i < source.size(); ++i) {
+            try {
+                encodeGenotype(source[i], genotype);
+            } catch (const std::out_of_range&) {
+                return false;
+            }
+            genotype.first_soc = static_cast<uint8_t>(first_soc);
+            problem.decodeGenotype(genotype, problem.parents[i]);
+        }
+        return true;
+    }
+
+    void ScheduleServer::evictRobots() {
+        while (robots.size() > options.max_cached_robots) {
+            auto oldest = std::min_element(robots.begin(), robots.end(), [](const auto& a, const auto& b) {
+                return a.second.last_used < b.second.last_used;
+            });
+            robots.erase(oldest);
+        }
+    }
+
+    void ScheduleServer::reply(int fd, const protocol::ScheduleReply& reply, const std::vector<protocol::FrontEntry>& front, Clock::time_point received) {
+        protocol::ScheduleReply timed = reply;
+        timed.server_seconds = static_cast<float>(secondsSince(received));
+        std::vector<uint8_t> payload;
+        protocol::encodeScheduleReply(timed, front, payload);
+        queueFrame(fd, protocol::MessageType::Schedule, payload);
+
+        double latency = secondsSince(received);
+        if (latencies.size() < options.latency_samples) {
+            latencies.push_back(latency);
+        } else {
+            latencies[latency_next] = latency;
+        }
+        latency_next = (latency_next + 1) % options.latency_samples;
+        ++requests;
+    }
+
+    void ScheduleServer::closeConnection(int fd) {
+        // 切断したクライアントの要求は最適化しない（fdが再利用されても応答が混ざらないように）
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [fd](const PendingRequest& request) { return request.fd == fd; }), pending.end());
+        connections.erase(std::remove_if(connections.begin(), connections.end(), [fd](const Connection& c) { return c.fd == fd; }), connections.end());
+        ::close(fd);
+    }
+
+    std::string ScheduleServer::statisticsText() const {
+        std::vector<double> sorted(latencies);
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](double p) {
+            if (sorted.empty()) return 0.0;
+            size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+            return 1000.0 * sorted[index];
+        };
+
+        std::ostringstream os;
+        os << "requests: " << requests << ", rejected: " << rejected << ", warm starts: " << warm_starts
+           << ", cached robots: " << robots.size() << std::endl;
+        os << "batches: " << batches << ", mean batch size: " << (batches ? static_cast<double>(batched_requests) / batches : 0.0)
+           << ", optimise: " << optimise_seconds << " s" << std::endl;
+        os << "latency [ms] (last " << sorted.size() << "): p50 " << percentile(0.5) << ", p90 " << percentile(0.9)
+           << ", p99 " << percentile(0.99) << ", max " << percentile(1.0) << std::endl;
+        return os.str();
+    }
+} // namespace charge_schedule
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include "station_timeline.hpp"
+
+namespace charge_schedule
+{
+    void StationTimeline::build(const std::vector<Window>& windows, int station_count) {
+        if (station_count <= 0) {
+            std::cerr << "station_countが無効です: " << station_count << std::endl;
+            throw std::invalid_argument("station_count is invalid");
+        }
+        stations.resize(station_count);
+        for (Station& station : stations) {
+            station.coordinates.clear();
+        }
+        for (const Window& window : windows) {
+            if (window.station < 0 || window.station >= station_count) {
+                std::cerr << "充電ステーションが無効です: " << window.station << std::endl;
+                throw std::invalid_argument("station is invalid");
+            }
+            stations[window.station].coordinates.push_back(window.begin);
+            stations[window.station].coordinates.push_back(window.end);
+        }
+        for (Station& station : stations) {
+            std::sort(station.coordinates.begin(), station.coordinates.end());
+            station.coordinates.erase(std::unique(station.coordinates.begin(), station.coordinates.end()), station.coordinates.end());
+            // 基本区間の数はcoordinates.size() - 1．領域は前の世代の分を再利用する
+            size_t nodes = 4 * std::max<size_t>(1, station.coordinates.size());
+            station.max_load.assign(nodes, 0);
+            station.add_load.assign(nodes, 0);
+        }
+    }
+
+    void StationTimeline::add(const Window& window, int delta) {
+        Station& station = stations[window.station];
+        const std::vector<float>& x = station.coordinates;
+        int begin = std::lower_bound(x.begin(), x.end(), window.begin) - x.begin();
+        int end = std::lower_bound(x.begin(), x.end(), window.end) - x.begin();
+        if (begin < end) {
+            add(station, 1, 0, static_cast<int>(x.size()) - 1, begin, end, delta);
+        }
+    }
+
+    int StationTimeline::maxLoad(int station_index, float begin, float end) const {
+        if (station_index < 0 || station_index >= stationCount() || !(begin < end)) {
+            return 0;
+        }
+        const Station& station = stations[station_index];
+        const std::vector<float>& x = station.coordinates;
+        if (x.size() < 2 || end <= x.front() || x.back() <= begin) {
+            return 0;
+        }
+        // 基本区間kは [x[k], x[k+1])．beginを含む区間からendの直前の区間まで
+        int first = std::max<int>(0, std::upper_bound(x.begin(), x.end(), begin) - x.begin() - 1);
+        int last = std::lower_bound(x.begin(), x.end(), end) - x.begin();
+        last = std::min<int>(last, static_cast<int>(x.size()) - 1);
+        if (first >= last) {
+            return 0;
+        }
+        return maxLoad(station, 1, 0, static_cast<int>(x.size()) - 1, first, last);
+    }
+
+    void StationTimeline::add(Station& station, int node, int node_begin, int node_end, int begin, int end, int delta) {
+        if (begin <= node_begin && node_end <= end) {
+            station.add_load[node] += delta;
+            station.max_load[node] += delta;
+            return;
+        }
+        int middle = (node_begin + node_end) / 2;
+        if (begin < middle) {
+            add(station, 2 * node, node_begin, middle, begin, end, delta);
+        }
+        if (middle < end) {
+            add(station, 2 * node + 1, middle, node_end, begin, end, delta);
+        }
+        station.max_load[node] = station.add_load[node] + std::max(station.max_load[2 * node], station.max_load[2 * node + 1]);
+    }
+
+    int StationTimeline::maxLoad(const Station& station, int node, int node_begin, int node_end, int begin, int end) const {
+        if (begin <= node_begin && node_end <= end) {
+            return station.max_load[node];
+        }
+        int middle = (node_begin + node_end) / 2;
+        int load = 0;
+        if (begin < middle) {
+            load = maxLoad(station, 2 * node, node_begin, middle, begin, end);
+        }
+        if (middle < end) {
+            load = std::max(load, maxLoad(station, 2 * node + 1, middle, node_end, begin, end));
+        }
+        return station.add_load[node] + load;
+    }
+
+    void StationTimeline::appendWindows(const nsgaii::Individual& individual, std::vector<Window>& windows) {
+        float elapsed_time = 0;
+        for (int i = 0; i < individual.charging_number; ++i) {
+            const std::array<float, 4>& span = individual.T_span[i];
+            float begin = elapsed_time + span[0];
+            float end = begin + span[1] + span[2] + span[3];
+            if (begin < end) {
+                windows.push_back({individual.charging_position[i], begin, end});
+            }
+            elapsed_time = end;
+        }
+    }
+} // namespace charge_schedule
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <set>
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+#include <yaml-cpp/yaml.h>
+#endif
+
+#include "termination.hpp"
+
+namespace nsgaii {
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
+   TerminationParameters loadTerminationParameters(const std::string& config_file_path) {
+      YAML::Node node;
+      try {
+         node = YAML::LoadFile(config_file_path);
+      } catch (const YAML::Exception& e) {
+         std::cerr << "YAMLファイルの読み込みに失敗しました: " << e.what() << std::endl;
+         throw std::runtime_error("YAML読み込みエラー");
+      }
+
+      // terminationセクションが無い場合は打ち切りを行わない
+      TerminationParameters parameters;
+      YAML::Node config = node["termination"];
+      if (config) {
+         parameters.enabled = config["enabled"].as<bool>();
+         parameters.window = config["window"].as<int>();
+         parameters.hv_tolerance = config["hv_tolerance"].as<double>();
+         parameters.front_stability = config["front_stability"].as<double>();
+         parameters.diversity_minimum = config["diversity_minimum"].as<double>();
+         parameters.max_restarts = config["max_restarts"].as<int>();
+         parameters.restart_elite_ratio = config["restart_elite_ratio"].as<double>();
+      }
+      return parameters;
+   }
+
+   ConvergenceMonitor::ConvergenceMonitor(const std::string& config_file_path, int population_size)
+   : ConvergenceMonitor(loadTerminationParameters(config_file_path), population_size)
+   {
+   }
+#endif
+
+   ConvergenceMonitor::ConvergenceMonitor(const TerminationParameters& parameters, int population_size)
+   : enabled_(parameters.enabled),
+   window(parameters.window),
+   hv_tolerance(parameters.hv_tolerance),
+   front_stability(parameters.front_stability),
+   diversity_minimum(parameters.diversity_minimum),
+   max_restarts(parameters.max_restarts),
+   restart_elite_ratio(parameters.restart_elite_ratio),
+   population_size(population_size)
+   {
+      if (window <= 0) {
+         std::cerr << "windowが無効です: " << window << std::endl;
+         throw std::invalid_argument("window is invalid");
+      }
+      if (restart_elite_ratio < 0 || 1 < restart_elite_ratio) {
+         std::cerr << "restart_elite_ratioが無効です: " << restart_elite_ratio << std::endl;
+         throw std::invalid_argument("restart_elite_ratio is invalid");
+      }
+      reset();
+   }
+
+   void ConvergenceMonitor::reset() {
+      generation = 0;
+      restarts = 0;
+      evaluations = population_size; // 初期個体群の評価
+      converged = false;
+      hv_history.clear();
+      stability_history.clear();
+      diversity_history.clear();
+      last_front.clear();
+      last_hv_improvement = 0;
+      last_front_stability = 0;
+      last_diversity = 0;
+   }
+
+   TerminationStatus ConvergenceMonitor::update(const std::vector<Individual>& parents, double hypervolume) {
+      ++generation;
+      evaluations += population_size; // 1世代あたり子個体群を評価
+
+      std::vector<std::pair<float, float>> front;
+      for (const auto& individual : parents) {
+         if (individual.fronts_count == 0) {
+            front.emplace_back(individual.f1, individual.f2);
+         }
+      }
+      std::sort(front.begin(), front.end());
+
+      last_front_stability = frontStability(front);
+      last_diversity = diversity(parents);
+      last_front = std::move(front);
+
+      hv_history.push_back(hypervolume);
+      stability_history.push_back(last_front_stability);
+      diversity_history.push_back(last_diversity);
+      if (hv_history.size() > static_cast<size_t>(window) + 1) hv_history.pop_front();
+      if (stability_history.size() > static_cast<size_t>(window)) stability_history.pop_front();
+      if (diversity_history.size() > static_cast<size_t>(window)) diversity_history.pop_front();
+
+      if (!enabled_ || hv_history.size() <= static_cast<size_t>(window)) {
+         return TerminationStatus::Continue;
+      }
+
+      // ウィンドウ内のハイパーボリューム相対改善量
+      double hv_now = hv_history.back();
+      last_hv_improvement = (hv_now > 0) ? (hv_now - hv_history.front()) / hv_now : 0.0;
+
+      bool front_stable = std::all_of(stability_history.begin(), stability_history.end(),
+                                      [&](double s) { return s >= front_stability; });
+      bool diversity_lost = std::all_of(diversity_history.begin(), diversity_history.end(),
+                                        [&](double d) { return d < diversity_minimum; });
+      bool stagnated = last_hv_improvement < hv_tolerance && front_stable;
+
+      if ((stagnated || diversity_lost) && restarts < max_restarts) {
+         ++restarts;
+         hv_history.clear();
+         stability_history.clear();
+         diversity_history.clear();
+         return TerminationStatus::Restart;
+      }
+      if (stagnated) {
+         converged = true;
+         return TerminationStatus::Converged;
+      }
+      return TerminationStatus::Continue;
+   }
+
+   void ConvergenceMonitor::addEvaluations(long evaluations) {
+      this->evaluations += evaluations;
+   }
+
+   int ConvergenceMonitor::eliteSize() const {
+      return static_cast<int>(std::ceil(restart_elite_ratio * population_size));
+   }
+
+   TerminationReport ConvergenceMonitor::report(int max_generation) const {
+      TerminationReport report;
+      report.generations = generation;
+      report.max_generation = max_generation;
+      report.generations_saved = std::max(0, max_generation - generation);
+      report.evaluations = evaluations;
+      report.evaluations_saved = static_cast<long>(report.generations_saved) * population_size;
+      report.restarts = restarts;
+      report.converged = converged;
+      return report;
+   }
+
+   void ConvergenceMonitor::printReport(std::ostream& os, int max_generation) const {
+      TerminationReport r = report(max_generation);
+      os << "--- termination ---" << std::endl;
+      os << "  generations: " << r.generations << " / " << r.max_generation
+         << " (saved " << r.generations_saved << ")" << std::endl;
+      os << "  evaluations: " << r.evaluations << " (saved " << r.evaluations_saved << ")" << std::endl;
+      os << "  restarts: " << r.restarts << ", converged: " << (r.converged ? "yes" : "no") << std::endl;
+   }
+
+   double ConvergenceMonitor::frontStability(const std::vector<std::pair<float, float>>& front) const {
+      if (front.empty() || last_front.empty()) {
+         return 0.0;
+      }
+      // 前世代のフロント0に同じ評価値が存在する個体の割合
+      size_t unchanged = 0;
+      for (const auto& point : front) {
+         if (std::binary_search(last_front.begin(), last_front.end(), point)) {
+            ++unchanged;
+         }
+      }
+      return static_cast<double>(unchanged) / front.size();
+   }
+
+   double ConvergenceMonitor::diversity(const std::vector<Individual>& parents) {
+      if (parents.empty()) {
+         return 0.0;
+      }
+      std::set<std::pair<float, float>> objectives;
+      for (const auto& individual : parents) {
+         objectives.insert({individual.f1, individual.f2});
+      }
+      return static_cast<double>(objectives.size()) / parents.size();
+   }
+} // namespace nsgaii
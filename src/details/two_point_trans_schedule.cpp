@@ -6,21 +6,114 @@
 #include <algorithm>
 #include <set>
 #include <utility>  
+#include <atomic>
+#include <thread>
+#include <stdexcept>
 #include "two_point_trans_schedule.hpp"
 
+namespace
+{
+    // 一括交叉の配列処理は分岐を条件選択にした単純なループで書き，コンパイラの自動ベクトル化に任せる
+
+    // std::floorと同じ切り捨て（丸め命令の無いSSE2でもベクトル化できる形）
+    inline int floorToInt(float x) {
+        int truncated = static_cast<int>(x);
+        return truncated - ((x < static_cast<float>(truncated)) ? 1 : 0);
+    }
+
+    // std::roundと同じ四捨五入（0から遠い方へ丸める）
+    inline int roundToInt(float x) {
+        int magnitude = floorToInt(std::fabs(x) + 0.5f);
+        return (x < 0) ? -magnitude : magnitude;
+    }
+
+    // float_sbxと同じ交叉．ownが自分側の親で，ペアのもう一方の子はownとotherを入れ替えて同じβで呼ぶ
+    // （出力ごとにループを分けるのは，別名チェックの数を抑えてベクトル化させるため）
+    void sbxLanes(const float* own, const float* other, const float* beta,
+                  const float* min_value, const float* max_value, float* child, size_t size) {
+        for (size_t k = 0; k < size; ++k) {
+            float value = 0.5f * ((1 + beta[k]) * own[k] + (1 - beta[k]) * other[k]);
+            float lower = min_value[k];
+            float upper = max_value[k];
+            value = (value < upper) ? value : upper;
+            child[k] = (value < lower) ? lower : value;
+        }
+    }
+
+    // int_sbxと同じ交叉（上限は100）
+    void socSbxLanes(const int* own, const int* other, const float* beta,
+                     const int* min_soc, int* child, size_t size) {
+        for (size_t k = 0; k < size; ++k) {
+            int soc = roundToInt(0.5f * ((1 + beta[k]) * own[k] + (1 - beta[k]) * other[k]));
+            int lower = min_soc[k];
+            soc = (soc < 100) ? soc : 100;
+            child[k] = (soc < lower) ? lower : soc;
+        }
+    }
+
+    // timePolynomialMutationを check < probability のレーンにだけ適用する
+    void timeMutationLanes(float* value, const float* delta, const float* check,
+                           const float* min_value, const float* max_value, float probability, size_t size) {
+        for (size_t k = 0; k < size; ++k) {
+            float mutated = value[k] + delta[k] * (max_value[k] - min_value[k]);
+            mutated = (mutated < min_value[k]) ? min_value[k] : ((max_value[k] < mutated) ? max_value[k] : mutated); // std::clamp
+            value[k] = (check[k] < probability) ? mutated : value[k];
+        }
+    }
+
+    // socPolynomialMutation（上限100）を check < probability のレーンにだけ適用する
+    void socMutationLanes(int* soc, const float* delta, const float* check,
+                          const int* min_soc, float probability, size_t size) {
+        for (size_t k = 0; k < size; ++k) {
+            int mutated = roundToInt(soc[k] + delta[k] * (100 - min_soc[k]));
+            mutated = (mutated < min_soc[k]) ? min_soc[k] : ((100 < mutated) ? 100 : mutated); // std::clamp
+            soc[k] = (check[k] < probability) ? mutated : soc[k];
+        }
+    }
+} // namespace
+
 namespace charge_schedule
 {
+#ifdef CHARGE_SCHEDULE_BAKED_PARAMS
+    TwoTransProblem::TwoTransProblem()
+    : TwoTransProblem(baked::scheduleParameters())
+    {
+    }
+
+    TwoTransProblem::TwoTransProblem(const nsgaii::ScheduleParameters& parameters)
+    : nsgaii::ScheduleNsgaii(parameters), soc_minimum(5)
+    {
+        const bool baked_sites = visited_number == baked::visited_number
+            && std::equal(T_move.begin(), T_move.end(), baked::T_move.begin()) && std::equal(T_standby.begin(), T_standby.end(), baked::T_standby.begin())
+            && std::equal(E_move.begin(), E_move.end(), baked::E_move.begin()) && std::equal(E_standby.begin(), E_standby.end(), baked::E_standby.begin());
+        if (!baked_sites) {
+            std::cerr << "訪問先ごとのパラメータが焼き込んだ値と一致しません" << std::endl;
+            throw std::invalid_argument("per-site parameters do not match the baked parameters");
+        }
+#else
     TwoTransProblem::TwoTransProblem(const std::string& config_file_path)
-    : nsgaii::ScheduleNsgaii(config_file_path), soc_minimum(5)
+    : TwoTransProblem(nsgaii::loadScheduleParameters(config_file_path))
+    {
+    }
+
+    TwoTransProblem::TwoTransProblem(const nsgaii::ScheduleParameters& parameters)
+    : nsgaii::ScheduleNsgaii(parameters), soc_minimum(5), T_cycle(0), E_cycle(0)
     {
+        // 2地点間の搬送問題なので，訪問先ごとのパラメータは[0]と[1]を必ず参照する
+        if (visited_number != 2) {
+            std::cerr << "visited_numberが無効です（2地点のみ）: " << visited_number << std::endl;
+            throw std::invalid_argument("visited_number must be 2");
+        }
         for (size_t i = 0; i < visited_number; ++i)
         {
             T_cycle += T_move[i] + T_standby[i]; // 3.0
             E_cycle += E_move[i] + E_standby[i]; // 4.9
         }
+#endif
         float W_total = W_target * E_cycle - E_cs[0]; // 総放電量
         min_charge_number = (W_total > 0) ? std::floor(W_total / 100) : 0;
 
+#ifndef CHARGE_SCHEDULE_BAKED_PARAMS
         T_timing.resize(4, 0);
         T_timing[0] = T_move[1] + T_standby[1] + T_move[0];     // last: 0, charge: 0, 2 min
         T_timing[1] = 0;                                        // last: 1, charge: 1, 0 min
@@ -31,13 +124,13 @@ namespace charge_schedule
         E_timing[1] = 0;                                         // 0
         E_timing[2] = E_standby[1] + E_move[0];                  // 2.49
         E_timing[3] = E_move[1];                                 // 0.83
+#endif
         // testTwenty();
     }
 
     nsgaii::Individual TwoTransProblem::generateIndividual(const bool& charging_number_random, const int& fixed_charging_number)
     {
-        std::random_device rd; // ノイズを使用したシード
-        std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
 
         std::uniform_int_distribution<> charging_number_dist(min_charge_number, max_charge_number);
 
@@ -101,24 +194,175 @@ namespace charge_schedule
     }
 
     void TwoTransProblem::generateFirstParents() {
+        regenerateParents(0);
+    }
+
+    void TwoTransProblem::regenerateParents(int begin) {
+        if (initial_sampler == nsgaii::InitialSampler::LatinHypercube) {
+            generateSampledParents(begin);
+            return;
+        }
+        // 充電回数の比率は生成し直す個体の数に対して決める（4回: 40%, 3回: 20%, 2回: 20%, 残りはランダム）
+        const size_t n = parents.size() - begin;
         bool charging_number_random = true;
-        for (int i = 0; i < parents.size(); ++i) {
-            if (i < 2*parents.size() / 5) {
+        for (size_t i = 0; i < n; ++i) {
+            nsgaii::Individual& parent = parents[begin + i];
+            if (i < 2*n / 5) {
                 charging_number_random = false;
-                parents[i] = generateIndividual(charging_number_random, 4);
-            } else if (i < 3*parents.size() / 5) {
+                parent = generateIndividual(charging_number_random, 4);
+            } else if (i < 3*n / 5) {
                 charging_number_random = false;
-                parents[i] = generateIndividual(charging_number_random, 3);
-            } else if (i < 4*parents.size() / 5) {
+                parent = generateIndividual(charging_number_random, 3);
+            } else if (i < 4*n / 5) {
                 charging_number_random = false;
-                parents[i] = generateIndividual(charging_number_random, 2);
+                parent = generateIndividual(charging_number_random, 2);
             } else {
                 charging_number_random = true;
-                parents[i] = generateIndividual(charging_number_random, 4);
+                parent = generateIndividual(charging_number_random, 4);
             }
         }
     }
 
+    void TwoTransProblem::generateSampledParents(int begin) {
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
+        const int n = parents.size() - begin;
+        if (n <= 0) return;
+        const int dimension = 3 * max_charge_number + 1; // 遺伝子ごとの3次元 + 充電回数
+
+        // ラテン超方格: 各次元を個体数で等分し，各区間から1点ずつ選ぶ
+        std::vector<float> samples(static_cast<size_t>(n) * dimension);
+        std::vector<int> strata(n);
+        std::uniform_real_distribution<float> jitter(0.0f, 1.0f);
+        for (int d = 0; d < dimension; ++d) {
+            for (int j = 0; j < n; ++j) {
+                strata[j] = j;
+            }
+            std::shuffle(strata.begin(), strata.end(), gen);
+            for (int j = 0; j < n; ++j) {
+                samples[static_cast<size_t>(j) * dimension + d] = std::min((strata[j] + jitter(gen)) / n, 0.99999f);
+            }
+        }
+
+        // 充電回数はgenerateFirstParentsと同じ比率（4回: 40%, 3回: 20%, 2回: 20%, 残りは範囲内で層別）
+        std::vector<int> charging_numbers(n);
+        for (int j = 0; j < n; ++j) {
+            if (j < 2 * n / 5) {
+                charging_numbers[j] = 4;
+            } else if (j < 3 * n / 5) {
+                charging_numbers[j] = 3;
+            } else if (j < 4 * n / 5) {
+                charging_numbers[j] = 2;
+            } else {
+                float u = samples[static_cast<size_t>(j) * dimension + dimension - 1];
+                charging_numbers[j] = min_charge_number + static_cast<int>(u * (max_charge_number - min_charge_number + 1));
+            }
+            charging_numbers[j] = std::max(1, std::min(charging_numbers[j], max_charge_number));
+        }
+
+        // 修復で使う乱数は個体ごとのシードから作るため，スレッド数によらず同じ個体群になる
+        std::vector<unsigned int> seeds(n);
+        for (int j = 0; j < n; ++j) {
+            seeds[j] = gen();
+        }
+
+        int thread_count = (initial_threads > 0) ? initial_threads : std::max(1u, std::thread::hardware_concurrency());
+        thread_count = std::max(1, std::min(thread_count, n));
+        std::atomic<int> next_index(0);
+        auto worker = [&]() {
+            int j;
+            while ((j = next_index.fetch_add(1)) < n) {
+                std::mt19937 local_engine(seeds[j]);
+                RandomEngineScope scope(local_engine);
+                parents[begin + j] = generateSampledIndividual(&samples[static_cast<size_t>(j) * dimension], charging_numbers[j]);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int t = 1; t < thread_count; ++t) {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+    }
+
+    nsgaii::Individual TwoTransProblem::generateSampledIndividual(const float* sample, int charging_number) {
+        nsgaii::Individual individual(max_charge_number);
+        individualResize(individual, charging_number);
+        individual.first_soc = 100;
+
+        int last_return_position = 0;
+        float elapsed_time = 0;
+        int W_total = 0;
+        for (int i = 0; i < charging_number; ++i) {
+            const float u_position = sample[3 * i];
+            const float u_cycle = sample[3 * i + 1];
+            const float u_soc = sample[3 * i + 2];
+
+            // SOCの下限を守れる充電位置のみを候補にする
+            int cycle_max[2] = {calcCycleMax(individual, 0, last_return_position, i), calcCycleMax(individual, 1, last_return_position, i)};
+            int charging_timing_position = (u_position < 0.5f) ? 0 : 1;
+            if (cycle_max[charging_timing_position] < 0 && cycle_max[1 - charging_timing_position] >= 0) {
+                charging_timing_position = 1 - charging_timing_position;
+            }
+            int return_position = (charging_timing_position == 0) ? 1 : 0;
+
+            // サイクル数: 充電ステーション到着時にSOCの下限を守れる範囲
+            // 目標タスク量を超える遺伝子は修復で切り捨てられ，充電回数の少ない個体になる
+            int cycle_high = std::max(cycle_max[charging_timing_position], 0);
+            int cycle = static_cast<int>(u_cycle * (cycle_high + 1));
+
+            individual.time_chromosome[i] = calcTimeChromosome(cycle, last_return_position, charging_timing_position, elapsed_time);
+            if (i == 0) {
+                individual.soc_charging_start[i] = calcSOCchargingStart(individual.first_soc, cycle, last_return_position, charging_timing_position);
+            } else if (last_return_position == 1) {
+                individual.soc_charging_start[i] = calcSOCchargingStart(individual.soc_chromosome[i - 1] - E_standby[1] - E_cs[1], cycle, last_return_position, charging_timing_position);
+            } else {
+                individual.soc_charging_start[i] = calcSOCchargingStart(individual.soc_chromosome[i - 1] - E_cs[0], cycle, last_return_position, charging_timing_position);
+            }
+            int W_after = W_total + calcTotalWork(cycle, last_return_position, charging_timing_position);
+
+            // 目標SOC: 最低充電量以上で，残りの作業時間を含めて最大作業時間に収まる範囲
+            int soc_low = static_cast<int>(std::min(individual.soc_charging_start[i] + charging_minimum, 100.0f));
+            float time_budget = T_max - (individual.time_chromosome[i] + T_cs[charging_timing_position] + T_cs[1] + T_standby[1])
+                              - std::max(W_target - W_after, 0) * T_cycle;
+            int soc_high = 100;
+            while (soc_high > soc_low && calcChargingTime(individual.soc_charging_start[i], soc_high) > time_budget) {
+                --soc_high;
+            }
+            individual.soc_chromosome[i] = soc_low + static_cast<int>(u_soc * (soc_high - soc_low + 1));
+
+            individual.T_span[i][0] = individual.time_chromosome[i] - elapsed_time;
+            individual.T_span[i][1] = T_cs[charging_timing_position];
+            individual.T_span[i][2] = calcChargingTime(individual.soc_charging_start[i], individual.soc_chromosome[i]);
+            individual.T_span[i][3] = (return_position == 0) ? T_cs[0] : T_cs[1] + T_standby[1];
+
+            W_total = W_after;
+            individual.W[i] = W_total;
+            individual.E_return[i] = (return_position == 0) ? E_cs[0] : E_cs[1] + E_standby[1];
+            individual.charging_position[i] = charging_timing_position;
+            individual.return_position[i] = return_position;
+            individual.cycle_count[i] = cycle;
+
+            elapsed_time += individual.T_span[i][0] + individual.T_span[i][1] + individual.T_span[i][2] + individual.T_span[i][3];
+            last_return_position = return_position;
+        }
+
+        fixAndPenalty(individual);
+        return individual;
+    }
+
+    int TwoTransProblem::partialRestart(int elite_size) {
+        // 上位elite_size個体を残し，残りの親個体をinitial_samplerで再生成する
+        const size_t begin = std::min(static_cast<size_t>(std::max(elite_size, 0)), parents.size());
+        regenerateParents(begin);
+        for (size_t i = begin; i < parents.size(); ++i) {
+            calucObjectiveFunction(parents[i]);
+        }
+        sortPopulation(parents);
+        return parents.size() - begin;
+    }
+
     void TwoTransProblem::generateChildren(bool random) {
         // size_t i = 0;
         // std::set<std::pair<float, float>> existing_objectives; // 評価値を記録するセット
@@ -162,6 +406,28 @@ namespace charge_schedule
         //     i += 2;
         // }
 
+        if (worker_threads != 1) {
+            // 子のペアを1タスクとしてワーク・スティーリングで生成する（crossover_modeより優先）
+            // 修復の有無や充電回数でペアごとの実行時間が大きく異なるため，静的には分割しない
+            parallelFor(children.size() / 2, [this, random](std::size_t k, int) {
+                std::pair<int, int> selected = random ? randomSelectionIndex() : rankingSelectionIndex();
+                std::pair<nsgaii::Individual, nsgaii::Individual> child = second_crossover(std::make_pair(parents[selected.first], parents[selected.second]));
+                children[2 * k] = std::move(child.first);
+                children[2 * k + 1] = std::move(child.second);
+            });
+            return;
+        }
+
+        if (crossover_mode == nsgaii::CrossoverMode::Batch || realtime) {
+            std::vector<std::pair<int, int>>& mating_pool = crossover_workspace.mating_pool;
+            mating_pool.resize(children.size() / 2);
+            for (std::pair<int, int>& selected : mating_pool) {
+                selected = random ? randomSelectionIndex() : rankingSelectionIndex();
+            }
+            batchCrossover(mating_pool, children);
+            return;
+        }
+
         std::pair<nsgaii::Individual, nsgaii::Individual> selected_parents = randomSelection();
         std::pair<nsgaii::Individual, nsgaii::Individual> child(selected_parents.first.charging_number, selected_parents.second.charging_number);
         size_t i = 0;
@@ -172,8 +438,8 @@ namespace charge_schedule
                 selected_parents = rankingSelection();
             }
             child = second_crossover(selected_parents);
-            children[i] = child.first;
-            children[i + 1] = child.second;
+            children[i] = std::move(child.first);
+            children[i + 1] = std::move(child.second);
             i += 2;
         }
         
@@ -181,6 +447,12 @@ namespace charge_schedule
     }
 
     void TwoTransProblem::evaluatePopulation(std::vector<nsgaii::Individual>& population) {
+        if (worker_threads != 1) {
+            parallelFor(population.size(), [this, &population](std::size_t index, int) {
+                calucObjectiveFunction(population[index]);
+            });
+            return;
+        }
         for (nsgaii::Individual& individual : population) {
             calucObjectiveFunction(individual);
         }
@@ -192,9 +464,6 @@ namespace charge_schedule
         child.first.first_soc = selected_parents.first.first_soc;
         child.second.first_soc = selected_parents.second.first_soc;
 
-        std::random_device rd; // ノイズを使用したシード
-        std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
-
         int i = 0;
         int c1_last_return_position = 0;
         int c2_last_return_position = 0;
@@ -270,8 +539,7 @@ namespace charge_schedule
             ++i;
         }
         while (i < child.second.charging_number) {
-            std::random_device rd; // ノイズを使用したシード
-            std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
+            std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
 
             std::uniform_int_distribution<> timing_dist(0, 1);
             int charging_timing_position = timing_dist(gen);
@@ -317,8 +585,7 @@ namespace charge_schedule
         child.first.first_soc = selected_parents.first.first_soc;
         child.second.first_soc = selected_parents.second.first_soc;
 
-        std::random_device rd; // ノイズを使用したシード
-        std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
 
         int i = 0;
         int c1_last_return_position = 0;
@@ -520,7 +787,271 @@ namespace charge_schedule
         return child;
     }
 
-    std::pair<int, int> TwoTransProblem::timeToCycleAndPosition(float& target_time, int& last_return_position, float& elapsed_time) {
+    void TwoTransProblem::GeneLanes::resize(size_t size) {
+        child.resize(size);
+        prev_soc.resize(size);
+        last_return.resize(size);
+        elapsed.resize(size);
+        own.resize(size);
+        time_min.resize(size);
+        time_max.resize(size);
+        cycle_max.resize(size);
+        cycle_max_position.resize(size);
+        value.resize(size);
+        soc_min.resize(size);
+        soc.resize(size);
+    }
+
+    void TwoTransProblem::reserveRealtime() {
+        nsgaii::ScheduleNsgaii::reserveRealtime();
+        // batchCrossoverが毎世代合わせる大きさを先に確保する
+        const size_t pair_count = children.size() / 2;
+        CrossoverWorkspace& workspace = crossover_workspace;
+        workspace.mating_pool.resize(pair_count);
+        workspace.last_return.resize(2 * pair_count);
+        workspace.elapsed.resize(2 * pair_count);
+        workspace.W_total.resize(2 * pair_count);
+        workspace.first.resize(pair_count);
+        workspace.second.resize(pair_count);
+        workspace.tail.resize(pair_count);
+        workspace.parent_soc_first.resize(pair_count);
+        workspace.parent_soc_second.resize(pair_count);
+        workspace.beta.resize(pair_count);
+        workspace.delta_first.resize(pair_count);
+        workspace.delta_second.resize(pair_count);
+        workspace.uniforms.resize(10 * pair_count);
+    }
+
+    void TwoTransProblem::batchCrossover(const std::vector<std::pair<int, int>>& mating_pool, std::vector<nsgaii::Individual>& offspring) {
+        const size_t pair_count = mating_pool.size();
+        if (offspring.size() < 2 * pair_count) {
+            std::cerr << "子個体の数が交配プールに対して不足しています: " << offspring.size() << std::endl;
+            throw std::invalid_argument("offspring is smaller than the mating pool");
+        }
+
+        CrossoverWorkspace& workspace = crossover_workspace;
+        workspace.last_return.assign(2 * pair_count, 0);
+        workspace.elapsed.assign(2 * pair_count, 0.0f);
+        workspace.W_total.assign(2 * pair_count, 0);
+        workspace.first.resize(pair_count);
+        workspace.second.resize(pair_count);
+        workspace.tail.resize(pair_count);
+        workspace.parent_soc_first.resize(pair_count);
+        workspace.parent_soc_second.resize(pair_count);
+        workspace.beta.resize(pair_count);
+        workspace.delta_first.resize(pair_count);
+        workspace.delta_second.resize(pair_count);
+        workspace.uniforms.resize(10 * pair_count);
+
+        // 子を親の長さで初期化する（Individual(charging_number)と同じ状態）
+        int gene_count = 0;
+        for (size_t k = 0; k < pair_count; ++k) {
+            for (int side = 0; side < 2; ++side) {
+                const nsgaii::Individual& parent = parents[side == 0 ? mating_pool[k].first : mating_pool[k].second];
+                nsgaii::Individual& child = offspring[2 * k + side];
+                individualResize(child, parent.charging_number);
+                std::fill(child.T_SOC_HiLow.begin(), child.T_SOC_HiLow.end(), 0.0f);
+                child.T_span[parent.charging_number] = {0, 0, 0, 0};
+                child.W[parent.charging_number] = 0;
+                child.cycle_count[parent.charging_number] = 0;
+                child.first_soc = parent.first_soc;
+                child.f1 = 0;
+                child.f2 = 0;
+                child.penalty = 0;
+                child.fronts_count = 0;
+                child.elapsed_time = 0;
+                gene_count = std::max(gene_count, parent.charging_number);
+            }
+        }
+
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
+        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+        for (int i = 0; i < gene_count; ++i) {
+            // 遺伝子iを持つ子をレーンに集める
+            auto gather = [&](GeneLanes& lanes, size_t lane, int c, float own) {
+                const nsgaii::Individual& child = offspring[c];
+                lanes.child[lane] = c;
+                lanes.prev_soc[lane] = (i == 0) ? child.first_soc : child.soc_chromosome[i - 1];
+                lanes.last_return[lane] = workspace.last_return[c];
+                lanes.elapsed[lane] = workspace.elapsed[c];
+                lanes.own[lane] = own;
+            };
+            size_t crossed = 0;
+            size_t tail = 0;
+            for (size_t k = 0; k < pair_count; ++k) {
+                const nsgaii::Individual& first_parent = parents[mating_pool[k].first];
+                const nsgaii::Individual& second_parent = parents[mating_pool[k].second];
+                if (i < first_parent.charging_number) {
+                    gather(workspace.first, crossed, 2 * k, first_parent.time_chromosome[i]);
+                    gather(workspace.second, crossed, 2 * k + 1, second_parent.time_chromosome[i]);
+                    workspace.parent_soc_first[crossed] = first_parent.soc_chromosome[i];
+                    workspace.parent_soc_second[crossed] = second_parent.soc_chromosome[i];
+                    ++crossed;
+                } else if (i < second_parent.charging_number) {
+                    gather(workspace.tail, tail, 2 * k + 1, second_parent.time_chromosome[i]);
+                    workspace.tail.soc[tail] = second_parent.soc_chromosome[i];
+                    ++tail;
+                }
+            }
+
+            // 一様乱数をまとめて引く（交叉するペア: SBX 1個・突然変異の判定とδ 各2個，長い側のみの子: 判定とδ 各1個）
+            const size_t time_draws = 5 * crossed + 2 * tail;
+            for (size_t n = 0; n < 2 * time_draws; ++n) {
+                workspace.uniforms[n] = dist(gen);
+            }
+            const float* u = workspace.uniforms.data();
+
+            // 時刻: 範囲 → SBX → 突然変異
+            batchCrossoverBounds(workspace.first, crossed, i == 0);
+            batchCrossoverBounds(workspace.second, crossed, i == 0);
+            batchCrossoverBounds(workspace.tail, tail, i == 0);
+
+            sbx_table.sbxBetas(u, workspace.beta.data(), crossed);
+            sbxLanes(workspace.first.own.data(), workspace.second.own.data(), workspace.beta.data(),
+                     workspace.first.time_min.data(), workspace.first.time_max.data(), workspace.first.value.data(), crossed);
+            sbxLanes(workspace.second.own.data(), workspace.first.own.data(), workspace.beta.data(),
+                     workspace.second.time_min.data(), workspace.second.time_max.data(), workspace.second.value.data(), crossed);
+            mutation_table.mutationDeltas(u + crossed, workspace.delta_first.data(), crossed);
+            mutation_table.mutationDeltas(u + 2 * crossed, workspace.delta_second.data(), crossed);
+            timeMutationLanes(workspace.first.value.data(), workspace.delta_first.data(), u + 3 * crossed,
+                              workspace.first.time_min.data(), workspace.first.time_max.data(), mutation_probability, crossed);
+            timeMutationLanes(workspace.second.value.data(), workspace.delta_second.data(), u + 4 * crossed,
+                              workspace.second.time_min.data(), workspace.second.time_max.data(), mutation_probability, crossed);
+
+            GeneLanes& tail_lanes = workspace.tail;
+            for (size_t k = 0; k < tail; ++k) {
+                tail_lanes.value[k] = (tail_lanes.own[k] < tail_lanes.time_min[k]) ? tail_lanes.time_min[k] : tail_lanes.own[k];
+            }
+            mutation_table.mutationDeltas(u + 5 * crossed, workspace.delta_first.data(), tail);
+            timeMutationLanes(tail_lanes.value.data(), workspace.delta_first.data(), u + 5 * crossed + tail,
+                              tail_lanes.time_min.data(), tail_lanes.time_max.data(), mutation_probability, tail);
+
+            // サイクル数・位置と充電開始SOCはレーンごとに逐次求める
+            batchCrossoverPlace(workspace.first, crossed, offspring, i);
+            batchCrossoverPlace(workspace.second, crossed, offspring, i);
+            batchCrossoverPlace(tail_lanes, tail, offspring, i);
+
+            // 目標SOC: SBX → 突然変異
+            u += time_draws;
+            sbx_table.sbxBetas(u, workspace.beta.data(), crossed);
+            socSbxLanes(workspace.parent_soc_first.data(), workspace.parent_soc_second.data(), workspace.beta.data(),
+                        workspace.first.soc_min.data(), workspace.first.soc.data(), crossed);
+            socSbxLanes(workspace.parent_soc_second.data(), workspace.parent_soc_first.data(), workspace.beta.data(),
+                        workspace.second.soc_min.data(), workspace.second.soc.data(), crossed);
+            mutation_table.mutationDeltas(u + crossed, workspace.delta_first.data(), crossed);
+            mutation_table.mutationDeltas(u + 2 * crossed, workspace.delta_second.data(), crossed);
+            socMutationLanes(workspace.first.soc.data(), workspace.delta_first.data(), u + 3 * crossed,
+                             workspace.first.soc_min.data(), mutation_probability, crossed);
+            socMutationLanes(workspace.second.soc.data(), workspace.delta_second.data(), u + 4 * crossed,
+                             workspace.second.soc_min.data(), mutation_probability, crossed);
+
+            for (size_t k = 0; k < tail; ++k) {
+                tail_lanes.soc[k] = (tail_lanes.soc[k] > tail_lanes.soc_min[k]) ? tail_lanes.soc[k] : tail_lanes.soc_min[k];
+            }
+            mutation_table.mutationDeltas(u + 5 * crossed, workspace.delta_first.data(), tail);
+            socMutationLanes(tail_lanes.soc.data(), workspace.delta_first.data(), u + 5 * crossed + tail,
+                             tail_lanes.soc_min.data(), mutation_probability, tail);
+
+            batchCrossoverClose(workspace.first, crossed, offspring, i);
+            batchCrossoverClose(workspace.second, crossed, offspring, i);
+            batchCrossoverClose(tail_lanes, tail, offspring, i);
+        }
+
+        for (size_t c = 0; c < 2 * pair_count; ++c) {
+            fixAndPenalty(offspring[c]);
+        }
+    }
+
+    void TwoTransProblem::batchCrossoverBounds(GeneLanes& lanes, size_t size, bool first_gene) {
+        // calcCycleMaxと同じ式で位置0・1それぞれのサイクル数上限を求め，小さい方を採る
+        const float offset_return0 = first_gene ? 0.0f : E_cs[0];
+        const float offset_return1 = first_gene ? 0.0f : E_cs[1] + E_standby[1];
+        const float E_cs0 = E_cs[0];
+        const float E_cs1 = E_cs[1];
+        const float T_standby0 = T_standby[0];
+        const float cycle_time = T_cycle;     // メンバを直接参照すると配列への書き込みとの別名を疑われてベクトル化されない
+        const float cycle_energy = E_cycle;
+        const int minimum_soc = soc_minimum;
+        const int* prev_soc = lanes.prev_soc.data();
+        const int* last_return = lanes.last_return.data();
+        const float* elapsed = lanes.elapsed.data();
+        int* cycle_max = lanes.cycle_max.data();
+        int* cycle_max_position = lanes.cycle_max_position.data();
+        float* time_min = lanes.time_min.data();
+        float* time_max = lanes.time_max.data();
+        for (size_t k = 0; k < size; ++k) {
+            float offset = (last_return[k] == 1) ? offset_return1 : offset_return0;
+            float remaining = static_cast<float>(prev_soc[k] - minimum_soc);
+            int cycle_max0 = floorToInt((remaining - (offset + E_cs0)) / cycle_energy);
+            int cycle_max1 = floorToInt((remaining - (offset + E_cs1)) / cycle_energy);
+            cycle_max[k] = (cycle_max0 <= cycle_max1) ? cycle_max0 : cycle_max1;
+            cycle_max_position[k] = (cycle_max0 <= cycle_max1) ? 0 : 1;
+        }
+        // 時刻の範囲は別のループにする（出力が多いと別名チェックが上限を超えてベクトル化されない）
+        for (size_t k = 0; k < size; ++k) {
+            float wait = (last_return[k] == 0) ? T_standby0 : 0.0f;
+            time_min[k] = elapsed[k] + wait;
+            time_max[k] = cycle_max[k] * cycle_time + elapsed[k];
+        }
+    }
+
+    void TwoTransProblem::batchCrossoverPlace(GeneLanes& lanes, size_t size, std::vector<nsgaii::Individual>& offspring, int i) {
+        for (size_t k = 0; k < size; ++k) {
+            nsgaii::Individual& child = offspring[lanes.child[k]];
+            int last_return_position = lanes.last_return[k];
+            std::pair<int, int> cycle_posit = timeToCycleAndPosition(lanes.value[k], last_return_position, lanes.elapsed[k]);
+            if (cycle_posit.first > lanes.cycle_max[k]) {
+                cycle_posit.first = lanes.cycle_max[k];
+                cycle_posit.second = lanes.cycle_max_position[k];
+            }
+            int cycle = cycle_posit.first;
+            int charging_timing_position = cycle_posit.second;
+
+            child.time_chromosome[i] = calcTimeChromosome(cycle, last_return_position, charging_timing_position, lanes.elapsed[k]);
+            if (i == 0) {
+                child.soc_charging_start[i] = calcSOCchargingStart(child.first_soc, cycle, last_return_position, charging_timing_position);
+            } else if (last_return_position == 1) {
+                child.soc_charging_start[i] = calcSOCchargingStart(child.soc_chromosome[i - 1] - E_standby[1] - E_cs[1], cycle, last_return_position, charging_timing_position);
+            } else {
+                child.soc_charging_start[i] = calcSOCchargingStart(child.soc_chromosome[i - 1] - E_cs[0], cycle, last_return_position, charging_timing_position);
+            }
+            child.cycle_count[i] = cycle;
+            child.charging_position[i] = charging_timing_position;
+
+            int target_soc_min = std::floor(child.soc_charging_start[i] + charging_minimum);
+            lanes.soc_min[k] = (target_soc_min >= 100) ? 100 : target_soc_min;
+        }
+    }
+
+    void TwoTransProblem::batchCrossoverClose(const GeneLanes& lanes, size_t size, std::vector<nsgaii::Individual>& offspring, int i) {
+        CrossoverWorkspace& workspace = crossover_workspace;
+        for (size_t k = 0; k < size; ++k) {
+            int c = lanes.child[k];
+            nsgaii::Individual& child = offspring[c];
+            int last_return_position = lanes.last_return[k];
+            int cycle = child.cycle_count[i];
+            int charging_timing_position = child.charging_position[i];
+            int return_position = (charging_timing_position == 0) ? 1 : 0;
+
+            child.soc_chromosome[i] = lanes.soc[k];
+
+            child.T_span[i][0] = child.time_chromosome[i] - lanes.elapsed[k];
+            child.T_span[i][1] = T_cs[charging_timing_position];
+            child.T_span[i][2] = calcChargingTime(child.soc_charging_start[i], child.soc_chromosome[i]);
+            child.T_span[i][3] = (return_position == 0) ? T_cs[return_position] : T_cs[return_position] + T_standby[1];
+
+            workspace.W_total[c] += calcTotalWork(cycle, last_return_position, charging_timing_position);
+            child.W[i] = workspace.W_total[c];
+            child.E_return[i] = (return_position == 0) ? E_cs[return_position] : E_cs[return_position] + E_standby[1];
+            child.return_position[i] = return_position;
+
+            workspace.elapsed[c] += child.T_span[i][0] + child.T_span[i][1] + child.T_span[i][2] + child.T_span[i][3];
+            workspace.last_return[c] = return_position;
+        }
+    }
+
+    std::pair<int, int> TwoTransProblem::timeToCycleAndPosition(float target_time, int last_return_position, float elapsed_time) const {
         float time = target_time - elapsed_time;
         int cycle = std::floor(time / T_cycle) + 1;
         float cycle_dec = time / T_cycle - std::floor(time / T_cycle);
@@ -558,87 +1089,7 @@ namespace charge_schedule
         return std::make_pair(cycle, position);
     }
 
-    std::pair<int, int> TwoTransProblem::int_sbx(int& p1, int& p2, std::pair<int, int>& gene_min, std::pair<int, int>& gene_max) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dist(0.0, 1.0);
-
-        float u = dist(gen);
-        float beta = (u <= 0.5) 
-                    ? pow(2 * u, 1.0 / (eta_sbx + 1)) 
-                    : pow(1.0 / (2 * (1 - u)), 1.0 / (eta_sbx + 1));
-
-        int c1 = std::round(0.5 * ((1 + beta) * p1 + (1 - beta) * p2));
-        int c2 = std::round(0.5 * ((1 - beta) * p1 + (1 + beta) * p2));
-
-        // 範囲を制限
-        c1 = std::max(gene_min.first, std::min(c1, gene_max.first));
-        c2 = std::max(gene_min.second, std::min(c2, gene_max.second));
-
-        return std::make_pair(c1, c2);
-    }
-
-    std::pair<float, float> TwoTransProblem::float_sbx(float& p1, float& p2, std::pair<float, float>& gene_min, std::pair<float, float>& gene_max) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dist(0.0, 1.0);
-
-        float u = dist(gen);
-        // u = 0.7;
-        float beta = (u <= 0.5) 
-                    ? pow(2 * u, 1.0 / (eta_sbx + 1)) 
-                    : pow(1.0 / (2 * (1 - u)), 1.0 / (eta_sbx + 1));
-
-        float c1 = 0.5 * ((1 + beta) * p1 + (1 - beta) * p2);
-        float c2 = 0.5 * ((1 - beta) * p1 + (1 + beta) * p2);
-
-        // 範囲を制限
-        c1 = std::max(gene_min.first, std::min(c1, gene_max.first));
-        c2 = std::max(gene_min.second, std::min(c2, gene_max.second));
-
-        return std::make_pair(c1, c2);
-    }
-
-    float TwoTransProblem::timePolynomialMutation(float gene, float max_gene, float min_gene) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(0.0, 1.0);
-
-        float u = dis(gen);  
-        float delta = 0.0f;
-
-        if (u < 0.5) {
-            delta = pow(2.0f * u, 1.0f / (eta_m + 1.0f)) - 1.0f;
-        } else {
-            delta = 1.0f - pow(2.0f * (1.0f - u), 1.0f / (eta_m + 1.0f));
-        }
-
-        float mutated_gene = gene + delta * (max_gene - min_gene);
-
-        return std::clamp(mutated_gene, min_gene, max_gene);
-    }
-
-    int TwoTransProblem::socPolynomialMutation(int gene, int max_gene, int min_gene) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<> dis(0.0, 1.0);
-
-        float u = dis(gen);  
-        float delta;
-
-        if (u < 0.5) {
-            delta = pow(2.0f * u, 1.0f / (eta_m + 1.0f)) - 1.0f;
-        } else {
-            delta = 1.0f - pow(2.0f * (1.0f - u), 1.0f / (eta_m + 1.0f));
-        }
-
-        float mutated_gene_float = gene + delta * (max_gene - min_gene);
-
-        int mutated_gene = static_cast<int>(std::round(mutated_gene_float));
-        return std::clamp(mutated_gene, min_gene, max_gene);
-    }
-
-    float TwoTransProblem::calcTimeChromosome(int& cycle, int& last_return, int& charging_position, float elapsed_time) {
+    float TwoTransProblem::calcTimeChromosome(int cycle, int last_return, int charging_position, float elapsed_time) const {
         float time = 0;
         if (cycle == 0) {
             if (last_return == charging_position) {
@@ -660,7 +1111,7 @@ namespace charge_schedule
         return time + elapsed_time;
     }
 
-    float TwoTransProblem::calcSOCchargingStart(float first_soc, int& cycle, int& last_return, int& charging_position) {
+    float TwoTransProblem::calcSOCchargingStart(float first_soc, int cycle, int last_return, int charging_position) const {
         float soc_charging_start = 0.0f;
         if (cycle == 0) {
             if (last_return == charging_position) {
@@ -682,7 +1133,7 @@ namespace charge_schedule
         return soc_charging_start;
     }
 
-    int TwoTransProblem::calcTotalWork(int& cycle, int& last_return, int& charging_position) {
+    int TwoTransProblem::calcTotalWork(int cycle, int last_return, int charging_position) const {
         int W_total = 0;
         if (cycle == 0) {
             if (last_return == charging_position) {
@@ -707,7 +1158,7 @@ namespace charge_schedule
         return W_total;
     }
 
-    int TwoTransProblem::calcCycleMax(nsgaii::Individual& individual, int charging_position, int& last_return_position, int& i) {
+    int TwoTransProblem::calcCycleMax(const nsgaii::Individual& individual, int charging_position, int last_return_position, int i) const {
         int soc_minimum_cycle  = 0;
         if (last_return_position == 1) {
             soc_minimum_cycle = (i == 0) 
@@ -721,7 +1172,7 @@ namespace charge_schedule
         return soc_minimum_cycle;
     }
 
-    float TwoTransProblem::calcElapsedTime(nsgaii::Individual& individual, int& i) {
+    float TwoTransProblem::calcElapsedTime(const nsgaii::Individual& individual, int i) const {
         float elapsed_time = 0;
         if (i != 0) {
             for (int j = 0; j < i; ++j) {
@@ -733,150 +1184,6 @@ namespace charge_schedule
         return elapsed_time;
     }
 
-    void TwoTransProblem::calucObjectiveFunction(nsgaii::Individual& individual)
-    {
-        calcSOCHiLow(individual);
-        individual.f1 = makespan(individual.T_span);
-        individual.f2 = soc_HiLowTime(individual.T_SOC_HiLow);
-    }
-
-    float TwoTransProblem::makespan(std::vector<std::array<float, 4>>& T_span)
-    {
-        float makespan = 0;
-        for (auto& span : T_span) {
-            for (auto& time : span) {
-                makespan += time;
-            }
-        }
-        if (makespan < 0) { std::cout << "make: エラー" << std::endl;}
-        return makespan;
-    }
-
-    float TwoTransProblem::soc_HiLowTime(std::vector<float> T_SOC_HiLow)
-    {
-        float hi_low_time = 0;
-        for (auto& time : T_SOC_HiLow) {
-            hi_low_time += time;
-        }
-        if (hi_low_time < 0) { std::cout << "soc: エラー" << std::endl;}
-        return hi_low_time;
-    }
-
-    void TwoTransProblem::calcSOCHiLow(nsgaii::Individual& individual) {
-        std::array<float, 3> T_socHi = {};
-        std::array<float, 3> T_socLow = {};
-        float last_final_soc = individual.first_soc;
-        for (int i = 0; i < individual.charging_number; ++i) {
-            float first_soc = last_final_soc;
-            float final_soc = (individual.return_position[i] == 0) ? individual.soc_chromosome[i] - individual.E_return[0] : individual.soc_chromosome[i] - individual.E_return[1] - E_standby[1];
-
-            if (SOC_Hi <= individual.soc_charging_start[i]) {
-                T_socHi[0] = individual.T_span[i][0] + individual.T_span[i][1];
-            } else if (individual.soc_charging_start[i] <= SOC_Hi && SOC_Hi <= first_soc) {
-                T_socHi[0] = ((first_soc - SOC_Hi) / (first_soc - individual.soc_charging_start[i])) * (individual.T_span[i][0] + individual.T_span[i][1]);
-            } else {
-                T_socHi[0] = 0;
-            }
-            if (T_socHi[0] < 0) { 
-                std::cout << "first_soc: " << first_soc << std::endl;
-                std::cout << "individual.soc_charging_start[i]: " << individual.soc_charging_start[i] << std::endl;
-                std::cout << "T_socHi[0]: エラー" << std::endl;
-            }
-
-            if (SOC_Hi <= individual.soc_charging_start[i]) {
-                T_socHi[1] = individual.T_span[i][2];
-            } else if (individual.soc_charging_start[i] <= SOC_Hi && SOC_Hi <= individual.soc_chromosome[i]) {
-                T_socHi[1] = (individual.soc_chromosome[i] - SOC_Hi) / r_cv;
-            } else {
-                T_socHi[1] = 0;
-            }
-            if (T_socHi[1] < 0) { std::cout << "T_socHi[1]: エラー" << std::endl;}
-
-            if (SOC_Hi <= final_soc) {
-                T_socHi[2] = individual.T_span[i][3];
-            } else if (final_soc <= SOC_Hi && SOC_Hi <= individual.soc_chromosome[i]) {
-                T_socHi[2] = ((individual.soc_chromosome[i] - SOC_Hi) / (individual.soc_chromosome[i] - final_soc)) * individual.T_span[i][3];
-            } else {
-                T_socHi[2] = 0;
-            }
-            if (T_socHi[2] < 0) { std::cout << "T_socHi[2]: エラー" << std::endl;}
-
-            if (first_soc <= SOC_Low) {
-                T_socLow[0] = individual.T_span[i][0] + individual.T_span[i][1];
-            } else if (individual.soc_charging_start[i] <= SOC_Low && SOC_Low <= first_soc) {
-                T_socLow[0] = ((SOC_Low - individual.soc_charging_start[i]) / (first_soc - individual.soc_charging_start[i])) * (individual.T_span[i][0] + individual.T_span[i][1]);
-            } else {
-                T_socLow[0] = 0;
-            }
-            if (T_socLow[0] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
-
-            if (individual.soc_chromosome[i] <= SOC_Low) {
-                T_socLow[1] = individual.T_span[i][2];
-            } else if (individual.soc_charging_start[i] <= SOC_Low && SOC_Low <= individual.soc_chromosome[i]) {
-                T_socLow[1] = (SOC_Low - individual.soc_charging_start[i]) / r_cc;
-            } else {
-                T_socLow[1] = 0;
-            }
-            if (T_socLow[1] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
-
-            if (individual.soc_chromosome[i] <= SOC_Low) {
-                T_socLow[2] = individual.T_span[i][3];
-            } else if (final_soc <= SOC_Low && SOC_Low <= individual.soc_chromosome[i]) {
-                T_socLow[2] = ((SOC_Low - final_soc) / (individual.soc_chromosome[i] - final_soc)) * individual.T_span[i][3];
-            } else {
-                T_socLow[2] = 0;
-            }
-            if (T_socLow[2] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
-
-            for (int j = 0; j < 3; ++j) {
-                individual.T_SOC_HiLow[i] += T_socHi[j] + T_socLow[j];
-            }
-
-            last_final_soc = final_soc;
-        }
-
-        float first_soc = last_final_soc;
-        float final_soc = first_soc - ((individual.T_span[individual.charging_number][0] / T_cycle) * E_cycle);
-
-        if (SOC_Hi <= final_soc) {
-            T_socHi[0] = individual.T_span[individual.charging_number][0];
-        } else if (final_soc <= SOC_Hi && SOC_Hi <= first_soc) {
-            T_socHi[0] = ((first_soc - SOC_Hi) / (first_soc - final_soc)) * individual.T_span[individual.charging_number][0];
-        } else {
-            T_socHi[0] = 0;
-        }
-        if (first_soc <= SOC_Low) {
-            T_socLow[0] = individual.T_span[individual.charging_number][0];
-        } else if (final_soc <= SOC_Low && SOC_Low <= first_soc) {
-            T_socLow[0] = ((SOC_Low - final_soc) / (first_soc - final_soc)) * individual.T_span[individual.charging_number][0];
-        } else {
-            T_socLow[0] = 0;
-        }
-        if (T_socHi[0] < 0) { 
-            std::cout << "first_soc: " << first_soc << std::endl;
-            std::cout << "individual.soc_charging_start[i]: " << final_soc << std::endl;
-            std::cout << "T_socHi[0]: エラー" << std::endl;
-        }
-        if (T_socLow[0] < 0) { std::cout << "T_socLow[0]: エラー" << std::endl;}
-
-        individual.T_SOC_HiLow[individual.charging_number] += T_socHi[0] + T_socLow[0];
-    }
-
-    float TwoTransProblem::calcChargingTime(float& soc_charging_start, int& soc_target)
-    {
-        float charging_time = 0;
-
-        if (SOC_cccv <= soc_charging_start){
-            charging_time = (soc_target - soc_charging_start) / r_cv;
-        } else if (soc_charging_start < SOC_cccv && SOC_cccv < soc_target){
-            charging_time = (SOC_cccv - soc_charging_start) / r_cc + (soc_target - SOC_cccv) / r_cv;
-        } else{
-            charging_time = (soc_target - soc_charging_start) / r_cc;
-        }
-
-        return charging_time;
-    }
-
     void TwoTransProblem::fixAndPenalty(nsgaii::Individual& individual) {
         if (individual.W[individual.charging_number - 1] < W_target) {
             individual.W[individual.charging_number] = W_target;
@@ -917,8 +1224,7 @@ namespace charge_schedule
     }
 
     void TwoTransProblem::additionalGen(nsgaii::Individual& individual) {
-        std::random_device rd; // ノイズを使用したシード
-        std::mt19937 gen(rd()); // メルセンヌ・ツイスタエンジン
+        std::mt19937& gen = randomEngine(); // 個体群ごとの乱数エンジン
         int last_return_position = individual.return_position[individual.charging_number - 1];
         float elapsed_time = calcElapsedTime(individual, individual.charging_number);
         int W_total = individual.W[individual.charging_number - 1];
@@ -980,35 +1286,60 @@ namespace charge_schedule
         individual.cycle_count.resize(new_charging_number + 1);
     }
 
-    float TwoTransProblem::calculateHypervolume(const std::vector<nsgaii::Individual>& pareto_front, const float& f1_reference, const float& f2_reference) {
-        if (pareto_front.empty()) {
-            return 0.0f; // パレートフロントが空の場合、ハイパーボリュームは 0
-        }
-
-        // ソート対象をコピー（const 安全性を保つため）
-        std::vector<nsgaii::Individual> sorted_pareto_front = pareto_front;
+    void TwoTransProblem::decodeGenotype(const CompactGenotype& genotype, nsgaii::Individual& individual) {
+        individualResize(individual, genotype.charging_number);
+        std::fill(individual.T_SOC_HiLow.begin(), individual.T_SOC_HiLow.end(), 0.0f);
+        individual.first_soc = genotype.first_soc;
+        individual.penalty = 0;
+        individual.fronts_count = 0;
+        individual.elapsed_time = 0;
 
-        // f1（第一目的関数）で降順ソート
-        std::sort(sorted_pareto_front.begin(), sorted_pareto_front.end(), [](const nsgaii::Individual& a, const nsgaii::Individual& b) {
-            return a.f1 > b.f1; // 第一目的関数でソート
-        });
+        // generateIndividualと同じ順序で派生値を計算する
+        int last_return_position = 0;
+        float elapsed_time = 0;
+        int W_total = 0;
+        for (int i = 0; i < individual.charging_number; ++i) {
+            int charging_timing_position = geneChargingPosition(genotype.genes[i]);
+            int return_position = (charging_timing_position == 0) ? 1 : 0;
+            int cycle = geneCycle(genotype.genes[i]);
 
-        float hypervolume = 0.0f;
-        float previous_f1 = f1_reference;
+            individual.time_chromosome[i] = calcTimeChromosome(cycle, last_return_position, charging_timing_position, elapsed_time);
+            if (i == 0) {
+                individual.soc_charging_start[i] = calcSOCchargingStart(individual.first_soc, cycle, last_return_position, charging_timing_position);
+            } else if (last_return_position == 1) {
+                individual.soc_charging_start[i] = calcSOCchargingStart(individual.soc_chromosome[i - 1] - E_standby[1] - E_cs[1], cycle, last_return_position, charging_timing_position);
+            } else {
+                individual.soc_charging_start[i] = calcSOCchargingStart(individual.soc_chromosome[i - 1] - E_cs[0], cycle, last_return_position, charging_timing_position);
+            }
+            individual.soc_chromosome[i] = geneSOC(genotype.genes[i]);
 
-        // 各点で長方形の面積を計算
-        for (const auto& individual : sorted_pareto_front) {
-            float width = previous_f1 - individual.f1; // f1 軸方向の差
-            float height = f2_reference - individual.f2; // f2 軸方向の差
+            individual.T_span[i][0] = individual.time_chromosome[i] - elapsed_time;
+            individual.T_span[i][1] = T_cs[charging_timing_position];
+            individual.T_span[i][2] = calcChargingTime(individual.soc_charging_start[i], individual.soc_chromosome[i]);
+            individual.T_span[i][3] = (return_position == 0) ? T_cs[0] : T_cs[1] + T_standby[1];
 
-            if (width > 0 && height > 0) { // 有効な領域のみ計算
-                hypervolume += width * height;
-            }
+            W_total += calcTotalWork(cycle, last_return_position, charging_timing_position);
+            individual.W[i] = W_total;
+            individual.E_return[i] = (return_position == 0) ? E_cs[0] : E_cs[1] + E_standby[1];
+            individual.charging_position[i] = charging_timing_position;
+            individual.return_position[i] = return_position;
+            individual.cycle_count[i] = cycle;
 
-            previous_f1 = individual.f1; // 次の区間に進む
+            elapsed_time += individual.T_span[i][0] + individual.T_span[i][1] + individual.T_span[i][2] + individual.T_span[i][3];
+            last_return_position = return_position;
         }
 
-        return hypervolume;
+        fixAndPenalty(individual);
+        calucObjectiveFunction(individual);
+    }
+
+    float TwoTransProblem::calculateHypervolume(const std::vector<nsgaii::Individual>& pareto_front, const float& f1_reference, const float& f2_reference) {
+        // 個体のコピーとソートを行わず，評価値のみを差分更新で集計する
+        nsgaii::HypervolumeTracker tracker(f1_reference, f2_reference);
+        for (const auto& individual : pareto_front) {
+            tracker.insert(individual.f1, individual.f2);
+        }
+        return tracker.hypervolume();
     }
 
     void TwoTransProblem::testTwenty() {
@@ -0,0 +1,186 @@
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include "work_stealing_pool.hpp"
+
+namespace nsgaii
+{
+   WorkStealingPool::WorkStealingPool(int threads)
+   : job_generation(0), running_workers(0), stopping(false), body(nullptr), remaining(0), run_seconds(0)
+   {
+      if (threads < 1) {
+         std::cerr << "ワーカー数が無効です: " << threads << std::endl;
+         throw std::invalid_argument("worker threads is invalid");
+      }
+      for (int w = 0; w < threads; ++w) {
+         workers.push_back(std::make_unique<Worker>());
+      }
+      seed(0);
+      for (int w = 1; w < threads; ++w) {
+         this->threads.emplace_back(&WorkStealingPool::workerLoop, this, w);
+      }
+   }
+
+   WorkStealingPool::~WorkStealingPool() {
+      {
+         std::lock_guard<std::mutex> lock(job_mutex);
+         stopping = true;
+      }
+      job_ready.notify_all();
+      for (std::thread& thread : threads) {
+         thread.join();
+      }
+   }
+
+   void WorkStealingPool::seed(unsigned int seed) {
+      for (std::size_t w = 0; w < workers.size(); ++w) {
+         std::seed_seq sequence{seed, static_cast<unsigned int>(w)};
+         workers[w]->engine.seed(sequence);
+      }
+   }
+
+   void WorkStealingPool::run(std::size_t count, const std::function<void(std::size_t, int)>& body) {
+      if (count == 0) {
+         return;
+      }
+      auto start = std::chrono::steady_clock::now();
+
+      // 添字を連続した区間に分けて各ワーカーの初期区間とする
+      const std::size_t n = workers.size();
+      for (std::size_t w = 0; w < n; ++w) {
+         std::lock_guard<std::mutex> lock(workers[w]->mutex);
+         workers[w]->head = w * count / n;
+         workers[w]->tail = (w + 1) * count / n;
+      }
+      failure = nullptr;
+      this->body = &body;
+      remaining.store(count, std::memory_order_release);
+
+      {
+         std::lock_guard<std::mutex> lock(job_mutex);
+         running_workers = static_cast<int>(n) - 1;
+         ++job_generation;
+      }
+      job_ready.notify_all();
+
+      work(0);
+
+      {
+         std::unique_lock<std::mutex> lock(job_mutex);
+         job_done.wait(lock, [this] { return running_workers == 0; });
+      }
+      this->body = nullptr;
+      run_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      if (failure) {
+         std::rethrow_exception(failure);
+      }
+   }
+
+   std::vector<WorkStealingPool::WorkerStatistics> WorkStealingPool::statistics() const {
+      std::vector<WorkerStatistics> result;
+      for (const std::unique_ptr<Worker>& worker : workers) {
+         double utilisation = (run_seconds > 0) ? worker->busy_seconds / run_seconds : 0.0;
+         result.push_back({worker->tasks, worker->steals, worker->busy_seconds, utilisation});
+      }
+      return result;
+   }
+
+   void WorkStealingPool::resetStatistics() {
+      for (std::unique_ptr<Worker>& worker : workers) {
+         worker->tasks = 0;
+         worker->steals = 0;
+         worker->busy_seconds = 0;
+      }
+      run_seconds = 0;
+   }
+
+   void WorkStealingPool::workerLoop(int worker) {
+      std::size_t seen_generation = 0;
+      while (true) {
+         {
+            std::unique_lock<std::mutex> lock(job_mutex);
+            job_ready.wait(lock, [&] { return stopping || job_generation != seen_generation; });
+            if (stopping) {
+               return;
+            }
+            seen_generation = job_generation;
+         }
+         work(worker);
+         {
+            std::lock_guard<std::mutex> lock(job_mutex);
+            if (--running_workers == 0) {
+               job_done.notify_one();
+            }
+         }
+      }
+   }
+
+   void WorkStealingPool::work(int worker) {
+      Worker& self = *workers[worker];
+      while (remaining.load(std::memory_order_acquire) > 0) {
+         std::size_t index;
+         if (popOwn(worker, index)) {
+            auto start = std::chrono::steady_clock::now();
+            try {
+               (*body)(index, worker);
+            } catch (...) {
+               std::lock_guard<std::mutex> lock(failure_mutex);
+               if (!failure) {
+                  failure = std::current_exception();
+               }
+            }
+            self.busy_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++self.tasks;
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+         } else if (!steal(worker)) {
+            std::this_thread::yield(); // 他のワーカーが最後のタスクを実行中
+         }
+      }
+   }
+
+   bool WorkStealingPool::popOwn(int worker, std::size_t& index) {
+      Worker& self = *workers[worker];
+      std::lock_guard<std::mutex> lock(self.mutex);
+      if (self.head == self.tail) {
+         return false;
+      }
+      index = --self.tail; // 自分の区間は末尾から
+      return true;
+   }
+
+   bool WorkStealingPool::steal(int worker) {
+      const int n = size();
+      for (int offset = 1; offset < n; ++offset) {
+         Worker& victim = *workers[(worker + offset) % n];
+         std::size_t begin = 0;
+         std::size_t end = 0;
+         {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            std::size_t available = victim.tail - victim.head;
+            if (available == 0) {
+               continue;
+            }
+            // 先頭側の半分（端数は切り上げ）を盗む
+            begin = victim.head;
+            end = begin + (available + 1) / 2;
+            victim.head = end;
+         }
+         Worker& self = *workers[worker];
+         std::lock_guard<std::mutex> lock(self.mutex);
+         self.head = begin;
+         self.tail = end;
+         ++self.steals;
+         return true;
+      }
+      return false;
+   }
+
+   WorkStealingPool& WorkStealingPoolHandle::get(int threads) {
+      if (!pool || pool->size() != threads) {
+         pool = std::make_unique<WorkStealingPool>(threads);
+      }
+      return *pool;
+   }
+} // namespace nsgaii
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "nsgaii_engine.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// 仮想関数経由の世代ループとテンプレートエンジン（NsgaiiEngine）の実行時間を比較する
+// 同じシードで両方を実行し，最終個体群のハイパーボリュームが一致しなければ終了コード1を返す
+// 最適化の効果を見るため Release ビルド（-DCMAKE_BUILD_TYPE=Release）での実行を想定
+// 使い方: engine_benchmark [世代数] [繰り返し回数]
+
+namespace
+{
+    // ScheduleNsgaiiの仮想インタフェースのみを通して実行する
+    double runVirtual(charge_schedule::TwoTransProblem& problem, int generations) {
+        nsgaii::ScheduleNsgaii& base = problem;
+        base.generateFirstParents();
+        base.evaluatePopulation(base.parents);
+        base.sortPopulation(base.parents);
+        for (int generation = 0; generation < generations; ++generation) {
+            problem.generateChildren(true);
+            base.evaluatePopulation(base.children);
+            base.generateCombinedPopulation();
+            base.sortPopulation(base.combind_population);
+            base.generateParents();
+        }
+        std::pair<float, float> reference = problem.hypervolumeReference();
+        return problem.calculateHypervolume(problem.parents, reference.first, reference.second);
+    }
+
+    double runEngine(charge_schedule::TwoTransProblem& problem, int generations) {
+        nsgaii::NsgaiiEngine<charge_schedule::TwoTransProblem> engine(problem);
+        engine.initialize();
+        engine.run(generations, true);
+        std::pair<float, float> reference = problem.hypervolumeReference();
+        return problem.calculateHypervolume(problem.parents, reference.first, reference.second);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int generations = (argc > 1) ? std::stoi(argv[1]) : 50;
+    int repetitions = (argc > 2) ? std::stoi(argv[2]) : 3;
+
+    charge_schedule::TwoTransProblem prototype(config_file_path);
+    const std::vector<int> population_sizes = {50, 200};
+
+    std::cout << "path,population_size,generations,ms_per_generation,hypervolume" << std::endl;
+    int mismatches = 0;
+    for (int population_size : population_sizes) {
+        double virtual_hyper_volume = 0;
+        for (const std::string path : {"virtual", "engine"}) {
+            double best_seconds = 0;
+            double hyper_volume = 0;
+            for (int repetition = 0; repetition < repetitions; ++repetition) {
+                charge_schedule::TwoTransProblem problem(prototype);
+                problem.setPopulationSize(population_size);
+                problem.setSeed(42);
+                auto start = std::chrono::steady_clock::now();
+                hyper_volume = (path == "virtual") ? runVirtual(problem, generations) : runEngine(problem, generations);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (repetition == 0 || seconds < best_seconds) {
+                    best_seconds = seconds;
+                }
+            }
+            std::cout << path << "," << population_size << "," << generations << ","
+                      << best_seconds * 1000.0 / generations << "," << hyper_volume << std::endl;
+            if (path == "virtual") {
+                virtual_hyper_volume = hyper_volume;
+            } else if (hyper_volume != virtual_hyper_volume) {
+                std::cerr << "ハイパーボリュームが一致しません（population_size " << population_size << "）: "
+                          << virtual_hyper_volume << " != " << hyper_volume << std::endl;
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches == 0 ? 0 : 1;
+}
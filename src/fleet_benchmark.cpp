@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "fleet_optimizer.hpp"
+
+// 複数台のロボットを1台ずつ順に最適化した場合と，FleetOptimizerでまとめて最適化した場合を比較する
+// ロボットごとのパラメータはYAMLの値の移動時間・放電量を±10%の範囲で揺らして作る
+// 同じシードなら両者のハイパーボリュームが一致することも確認する
+// ステーションの容量を指定した場合は，ロボット間の混雑を含むためハイパーボリュームの一致は確認しない
+// 使い方: fleet_benchmark [ロボット数] [世代数] [スレッド数（0: ハードウェアのスレッド数）] [ステーションの容量（0: 制約なし）]
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int robot_count = (argc > 1) ? std::stoi(argv[1]) : 16;
+    int max_generation = (argc > 2) ? std::stoi(argv[2]) : 50;
+    int thread_count = (argc > 3) ? std::stoi(argv[3]) : 0;
+    int station_capacity = (argc > 4) ? std::stoi(argv[4]) : 0;
+
+    nsgaii::ScheduleParameters base = nsgaii::loadScheduleParameters(config_file_path);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> scale_dist(0.9f, 1.1f);
+    std::vector<nsgaii::ScheduleParameters> robots(robot_count, base);
+    for (nsgaii::ScheduleParameters& robot : robots) {
+        for (int i = 0; i < robot.visited_number; ++i) {
+            robot.T_move[i] *= scale_dist(gen);
+            robot.E_move[i] *= scale_dist(gen);
+            robot.E_cs[i] *= scale_dist(gen);
+        }
+    }
+
+    charge_schedule::FleetOptions options;
+    options.thread_count = thread_count;
+    options.max_generation = max_generation;
+    options.base_seed = 42;
+    if (station_capacity > 0) {
+        options.station_capacity = {station_capacity, station_capacity}; // 充電位置0・1
+    }
+
+    // 1台ずつ順に実行（FleetOptimizerと同じシード・同じ世代ループ）
+    std::vector<double> sequential_hypervolume(robot_count);
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < robot_count; ++r) {
+        charge_schedule::TwoTransProblem problem(robots[r]);
+        problem.setWorkerThreads(1);
+        problem.setSeed(options.base_seed + r);
+        problem.generateFirstParents();
+        problem.evaluatePopulation(problem.parents);
+        problem.sortPopulation(problem.parents);
+        problem.updateArchiveHypervolume(problem.parents);
+        for (int generation = 0; generation < max_generation; ++generation) {
+            problem.generateChildren(options.random_selection);
+            problem.evaluatePopulation(problem.children);
+            problem.generateCombinedPopulation();
+            problem.sortPopulation(problem.combind_population);
+            problem.generateParents();
+            problem.updateArchiveHypervolume(problem.children);
+        }
+        sequential_hypervolume[r] = problem.archiveHypervolume();
+    }
+    double sequential_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    charge_schedule::FleetOptimizer fleet(robots, options);
+    charge_schedule::FleetResult result = fleet.run();
+
+    int mismatches = 0;
+    for (int r = 0; r < robot_count && station_capacity <= 0; ++r) {
+        if (std::abs(result.robots[r].hypervolume - sequential_hypervolume[r]) > 1e-6) {
+            ++mismatches;
+        }
+    }
+
+    fleet.printSummary(result, std::cout);
+    std::cout << "mode,robots,generations,seconds,robots_per_second,hypervolume_mismatches" << std::endl;
+    std::cout << "sequential," << robot_count << "," << max_generation << "," << sequential_seconds << ","
+              << robot_count / sequential_seconds << ",0" << std::endl;
+    std::cout << "fleet," << robot_count << "," << max_generation << "," << result.elapsed_seconds << ","
+              << robot_count / result.elapsed_seconds << "," << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
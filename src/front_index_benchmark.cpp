@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "front_index.hpp"
+
+// FrontIndexの構築と問い合わせの時間を測定し，全解の走査による結果と照合する
+// 前線は f2 = c / f1 の形の曲線にノイズを加えた点（支配される点を含む）を乱数で作る
+// 使い方: front_index_benchmark [点の数] [問い合わせ回数]
+
+int main(int argc, char** argv)
+{
+    int point_count = (argc > 1) ? std::stoi(argv[1]) : 100000;
+    int query_count = (argc > 2) ? std::stoi(argv[2]) : 100000;
+
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> f1_dist(100.0f, 400.0f);
+    std::uniform_real_distribution<float> noise_dist(0.0f, 5.0f);
+    std::vector<nsgaii::Individual> population;
+    population.reserve(point_count);
+    for (int i = 0; i < point_count; ++i) {
+        nsgaii::Individual individual(1);
+        individual.f1 = f1_dist(gen);
+        individual.f2 = 4000.0f / individual.f1 + noise_dist(gen);
+        individual.penalty = 0;
+        individual.charging_number = 1;
+        individual.first_soc = 80;
+        individual.time_chromosome[0] = individual.f1 / 2;
+        individual.soc_chromosome[0] = 90;
+        individual.charging_position[0] = 0;
+        individual.return_position[0] = 1;
+        individual.cycle_count[0] = 3;
+        population.push_back(individual);
+    }
+
+    charge_schedule::FrontIndex index;
+    auto start = std::chrono::steady_clock::now();
+    index.add(population);
+    index.build();
+    double build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const std::vector<charge_schedule::DecodedSchedule>& front = index.front();
+
+    // 問い合わせ（f1の上限・f2の上限・重み）を乱数で作る
+    std::uniform_real_distribution<float> max_f1_dist(90.0f, 410.0f);
+    std::uniform_real_distribution<float> max_f2_dist(5.0f, 50.0f);
+    std::uniform_real_distribution<float> weight_dist(0.0f, 1.0f);
+    std::vector<float> max_f1(query_count);
+    std::vector<float> max_f2(query_count);
+    std::vector<float> weight(query_count);
+    for (int q = 0; q < query_count; ++q) {
+        max_f1[q] = max_f1_dist(gen);
+        max_f2[q] = max_f2_dist(gen);
+        weight[q] = weight_dist(gen);
+    }
+
+    double checksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int q = 0; q < query_count; ++q) {
+        const charge_schedule::DecodedSchedule* a = index.minF2WithF1AtMost(max_f1[q]);
+        const charge_schedule::DecodedSchedule* b = index.minF1WithF2AtMost(max_f2[q]);
+        const charge_schedule::DecodedSchedule* c = index.weighted(weight[q]);
+        checksum += (a ? a->f2 : 0) + (b ? b->f1 : 0) + c->f1;
+    }
+    double query_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 一部の問い合わせを全解の走査と照合する
+    const float f1_min = front.front().f1;
+    const float f1_range = std::max(front.back().f1 - f1_min, 1e-6f);
+    const float f2_min = front.back().f2;
+    const float f2_range = std::max(front.front().f2 - f2_min, 1e-6f);
+    int mismatches = 0;
+    int checked = std::min(query_count, 2000);
+    for (int q = 0; q < checked; ++q) {
+        const charge_schedule::DecodedSchedule* expected_a = nullptr;
+        const charge_schedule::DecodedSchedule* expected_b = nullptr;
+        float expected_c = 0;
+        for (size_t i = 0; i < front.size(); ++i) {
+            const charge_schedule::DecodedSchedule& s = front[i];
+            if (s.f1 <= max_f1[q] && (!expected_a || s.f2 < expected_a->f2)) expected_a = &s;
+            if (s.f2 <= max_f2[q] && (!expected_b || s.f1 < expected_b->f1)) expected_b = &s;
+            float value = weight[q] * (s.f1 - f1_min) / f1_range + (1 - weight[q]) * (s.f2 - f2_min) / f2_range;
+            if (i == 0 || value < expected_c) expected_c = value;
+        }
+        const charge_schedule::DecodedSchedule* c = index.weighted(weight[q]);
+        float value_c = weight[q] * (c->f1 - f1_min) / f1_range + (1 - weight[q]) * (c->f2 - f2_min) / f2_range;
+        if (index.minF2WithF1AtMost(max_f1[q]) != expected_a) ++mismatches;
+        if (index.minF1WithF2AtMost(max_f2[q]) != expected_b) ++mismatches;
+        if (std::abs(value_c - expected_c) > 1e-5f) ++mismatches;
+    }
+
+    std::cout << "points: " << point_count << ", front: " << index.size() << std::endl;
+    std::cout << "build: " << build_seconds * 1000 << " ms" << std::endl;
+    std::cout << "query: " << query_seconds / (3.0 * query_count) * 1e9 << " ns/query (" << 3 * query_count << " queries, checksum " << checksum << ")" << std::endl;
+    std::cout << "checked: " << 3 * checked << ", mismatches: " << mismatches << std::endl;
+    if (index.knee()) {
+        std::cout << "knee: f1 " << index.knee()->f1 << ", f2 " << index.knee()->f2 << std::endl;
+        std::cout << "closest to utopia: f1 " << index.closestToUtopia()->f1 << ", f2 " << index.closestToUtopia()->f2 << std::endl;
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "front_reader.hpp"
+
+// 共有メモリに公開された第1前線を監視し，世代が進むたびに概要を表示する
+// 使い方: front_watch [共有メモリの名前] [確認間隔 ms] [表示する回数（0: 無制限）]
+
+int main(int argc, char** argv)
+{
+    std::string name = (argc > 1) ? argv[1] : "/charge_schedule_front";
+    int interval_ms = (argc > 2) ? std::stoi(argv[2]) : 100;
+    int max_updates = (argc > 3) ? std::stoi(argv[3]) : 0;
+
+    charge_schedule::FrontReader reader(name);
+    std::cout << "writer pid: " << reader.writerPid() << ", capacity: " << reader.capacity() << std::endl;
+
+    charge_schedule::FrontSnapshot snapshot;
+    int64_t last_generation = -1;
+    int updates = 0;
+    while (max_updates == 0 || updates < max_updates) {
+        int64_t generation = reader.latestGeneration();
+        if (generation != last_generation && reader.read(snapshot)) {
+            last_generation = static_cast<int64_t>(snapshot.generation);
+            float best_f1 = 0;
+            float best_f2 = 0;
+            for (size_t i = 0; i < snapshot.front.size(); ++i) {
+                if (i == 0 || snapshot.front[i].f1 < best_f1) best_f1 = snapshot.front[i].f1;
+                if (i == 0 || snapshot.front[i].f2 < best_f2) best_f2 = snapshot.front[i].f2;
+            }
+            std::cout << snapshot.generation << ". front " << snapshot.front.size() << ", hyper_volume " << snapshot.hypervolume
+                      << ", min f1 " << best_f1 << ", min f2 " << best_f2 << ", retries " << reader.retries() << std::endl;
+            ++updates;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+    return 0;
+}
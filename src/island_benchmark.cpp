@@ -0,0 +1,49 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "island_model.hpp"
+
+// 島の数ごとに島モデルを実行し，ハイパーボリュームと経過時間の関係をCSVで出力する
+// 使い方: island_benchmark [最大世代数] [移住間隔]
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int max_generation = (argc > 1) ? std::stoi(argv[1]) : 100;
+    int migration_interval = (argc > 2) ? std::stoi(argv[2]) : 10;
+    std::vector<int> island_counts = {1, 4, 16, 32};
+
+    std::cout << "islands,generation,elapsed_s,best_island_hv" << std::endl;
+    std::vector<std::pair<double, double>> summary;
+    for (int island_count : island_counts) {
+        charge_schedule::IslandModelOptions options;
+        options.island_count = island_count;
+        options.max_generation = max_generation;
+        options.migration_interval = migration_interval;
+        options.base_seed = 12345;
+
+        charge_schedule::IslandModel model(config_file_path, options);
+        model.run();
+
+        // 世代ごとに全島の最良ハイパーボリュームと最も遅い島の経過時間を出力
+        const auto& progress = model.progress();
+        for (int generation = 0; generation <= max_generation; ++generation) {
+            double elapsed = 0;
+            double best_hv = 0;
+            for (const auto& history : progress) {
+                elapsed = std::max(elapsed, history[generation].elapsed_seconds);
+                best_hv = std::max(best_hv, history[generation].hypervolume);
+            }
+            std::cout << island_count << "," << generation << "," << elapsed << "," << best_hv << std::endl;
+        }
+        summary.emplace_back(model.elapsedSeconds(), model.mergedHypervolume());
+    }
+
+    std::cout << std::endl;
+    std::cout << "islands,wall_clock_s,merged_hv" << std::endl;
+    for (size_t i = 0; i < island_counts.size(); ++i) {
+        std::cout << island_counts[i] << "," << summary[i].first << "," << summary[i].second << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "fixed_individual.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// 復号・評価・ソートのホットパスを個体群サイズと最大充電回数ごとに計測し，
+// 1回あたりの時間[ns]とメモリ確保回数を出力する
+// 使い方: micro_benchmark [1ケースあたりの最小計測時間 s]
+
+namespace
+{
+    double min_seconds = 0.2;
+
+    template <typename Function>
+    void measure(const std::string& name, int population_size, int max_charge_number, Function function)
+    {
+        using clock = std::chrono::steady_clock;
+        function(); // ウォームアップ
+
+        long iterations = 0;
+        uint64_t allocations = 0;
+        double elapsed = 0;
+        long batch = 1;
+        while (elapsed < min_seconds) {
+            uint64_t allocations_before = nsgaii::AllocationCounter::count();
+            auto start = clock::now();
+            for (long i = 0; i < batch; ++i) {
+                function();
+            }
+            elapsed += std::chrono::duration<double>(clock::now() - start).count();
+            allocations += nsgaii::AllocationCounter::count() - allocations_before;
+            iterations += batch;
+            batch *= 2;
+        }
+
+        std::cout << name << "," << population_size << "," << max_charge_number << ","
+                  << std::fixed << std::setprecision(1) << elapsed * 1e9 / iterations << ","
+                  << std::setprecision(2) << static_cast<double>(allocations) / iterations << ","
+                  << iterations << std::defaultfloat << std::endl;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    if (argc > 1) {
+        min_seconds = std::stod(argv[1]);
+    }
+
+    const std::vector<int> population_sizes = {50, 200, 800};
+    const std::vector<int> max_charge_numbers = {8, 20, 40};
+    charge_schedule::TwoTransProblem prototype(config_file_path);
+
+    std::cout << "benchmark,population_size,max_charge_number,ns_per_op,allocs_per_op,iterations" << std::endl;
+    for (int population_size : population_sizes) {
+        for (int max_charge_number : max_charge_numbers) {
+            charge_schedule::TwoTransProblem nsgaii(prototype);
+            nsgaii.setSeed(42);
+            nsgaii.setMaxChargeNumber(max_charge_number);
+            nsgaii.setPopulationSize(population_size);
+            nsgaii.generateFirstParents();
+            nsgaii.evaluatePopulation(nsgaii.parents);
+            nsgaii.sortPopulation(nsgaii.parents);
+            nsgaii.generateChildren(true);
+            nsgaii.evaluatePopulation(nsgaii.children);
+            nsgaii.generateCombinedPopulation();
+
+            // 計測対象の入力は固定シードで事前に用意する
+            std::vector<std::pair<nsgaii::Individual, nsgaii::Individual>> selected;
+            for (int i = 0; i < 16; ++i) {
+                selected.push_back(nsgaii.randomSelection());
+            }
+            size_t next = 0;
+
+            measure("generateIndividual", population_size, max_charge_number, [&]() {
+                nsgaii::Individual individual = nsgaii.generateIndividual(true, 4);
+                (void)individual;
+            });
+            measure("second_crossover", population_size, max_charge_number, [&]() {
+                auto child = nsgaii.second_crossover(selected[next++ % selected.size()]);
+                (void)child;
+            });
+            measure("int_sbx", population_size, max_charge_number, [&]() {
+                int p1 = 3, p2 = 7;
+                std::pair<int, int> gene_min(0, 0), gene_max(10, 10);
+                auto c = nsgaii.int_sbx(p1, p2, gene_min, gene_max);
+                (void)c;
+            });
+            measure("float_sbx", population_size, max_charge_number, [&]() {
+                float p1 = 12.5f, p2 = 30.0f;
+                std::pair<float, float> gene_min(0, 0), gene_max(60, 60);
+                auto c = nsgaii.float_sbx(p1, p2, gene_min, gene_max);
+                (void)c;
+            });
+            measure("individual_copy", population_size, max_charge_number, [&]() {
+                nsgaii::Individual copy = nsgaii.children[next++ % nsgaii.children.size()];
+                (void)copy;
+            });
+            // 固定長個体は実行時のmax_charge_numberから容量を選んでmemcpyでコピーする
+            nsgaii::dispatchFixedCapacity(max_charge_number, [&](auto capacity) {
+                std::vector<nsgaii::FixedIndividual<capacity>> fixed_population(nsgaii.children.size());
+                for (size_t i = 0; i < fixed_population.size(); ++i) {
+                    nsgaii::toFixed(nsgaii.children[i], fixed_population[i]);
+                }
+                nsgaii::FixedIndividual<capacity> copy;
+                measure("fixed_copy", population_size, max_charge_number, [&]() {
+                    std::memcpy(&copy, &fixed_population[next++ % fixed_population.size()], sizeof(copy));
+                });
+            });
+            std::vector<charge_schedule::CompactGenotype> genotypes(nsgaii.children.size());
+            measure("encodeGenotype", population_size, max_charge_number, [&]() {
+                size_t index = next++ % genotypes.size();
+                charge_schedule::encodeGenotype(nsgaii.children[index], genotypes[index]);
+            });
+            nsgaii::Individual decoded(max_charge_number);
+            measure("decodeGenotype", population_size, max_charge_number, [&]() {
+                nsgaii.decodeGenotype(genotypes[next++ % genotypes.size()], decoded);
+            });
+            std::vector<nsgaii::Individual> evaluation_copy = nsgaii.children;
+            measure("calucObjectiveFunction", population_size, max_charge_number, [&]() {
+                nsgaii::Individual& individual = evaluation_copy[next++ % evaluation_copy.size()];
+                std::fill(individual.T_SOC_HiLow.begin(), individual.T_SOC_HiLow.end(), 0.0f);
+                nsgaii.calucObjectiveFunction(individual);
+            });
+            measure("fixAndPenalty", population_size, max_charge_number, [&]() {
+                nsgaii.fixAndPenalty(evaluation_copy[next++ % evaluation_copy.size()]);
+            });
+            measure("nonDominatedSorting", population_size, max_charge_number, [&]() {
+                auto fronts = nsgaii.nonDominatedSorting(nsgaii.combind_population);
+                (void)fronts;
+            });
+            std::vector<std::vector<int>> fronts = nsgaii.nonDominatedSorting(nsgaii.combind_population);
+            std::vector<nsgaii::Individual> crowding_copy = nsgaii.combind_population;
+            measure("crowdingSorting", population_size, max_charge_number, [&]() {
+                nsgaii.crowdingSorting(fronts, crowding_copy);
+            });
+            measure("generation", population_size, max_charge_number, [&]() {
+                nsgaii.generateChildren(true);
+                nsgaii.evaluatePopulation(nsgaii.children);
+                nsgaii.generateCombinedPopulation();
+                nsgaii.sortPopulation(nsgaii.combind_population);
+                nsgaii.generateParents();
+            });
+        }
+    }
+    return 0;
+}
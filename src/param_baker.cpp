@@ -0,0 +1,114 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "nsgaii.hpp"
+#include "termination.hpp"
+
+// YAMLのパラメータをconstexprの定数を並べたヘッダ（baked_parameter_values.hpp）へ変換する
+// ビルド時にCMakeから呼ばれ，焼き込み版（CHARGE_SCHEDULE_BAKED_PARAMS）はこのヘッダを使ってyaml-cppなしで構築する
+// 読み込みと検証はloadScheduleParameters・loadTerminationParametersをそのまま使う
+// 使い方: param_baker <YAMLファイル> <出力ヘッダ>
+
+namespace
+{
+    // floatとして読み戻したときに同じ値になる桁数で書く
+    std::string floatLiteral(float value) {
+        std::ostringstream os;
+        os << std::setprecision(std::numeric_limits<float>::max_digits10) << value;
+        std::string text = os.str();
+        if (text.find_first_of(".e") == std::string::npos) {
+            text += ".0";
+        }
+        return text + "f";
+    }
+
+    std::string doubleLiteral(double value) {
+        std::ostringstream os;
+        os << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+        std::string text = os.str();
+        if (text.find_first_of(".e") == std::string::npos) {
+            text += ".0";
+        }
+        return text;
+    }
+
+    std::string floatArray(const std::vector<float>& values) {
+        std::string text = "{";
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i != 0) text += ", ";
+            text += floatLiteral(values[i]);
+        }
+        return text + "}";
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 3) {
+        std::cerr << "使い方: param_baker <YAMLファイル> <出力ヘッダ>" << std::endl;
+        return 1;
+    }
+    const std::string config_file_path = argv[1];
+    const std::string output_path = argv[2];
+
+    const nsgaii::ScheduleParameters p = nsgaii::loadScheduleParameters(config_file_path);
+    const nsgaii::TerminationParameters t = nsgaii::loadTerminationParameters(config_file_path);
+
+    const char* survivor_selection = (p.survivor_selection == nsgaii::SurvivorSelection::Hypervolume) ? "Hypervolume" : "Crowding";
+    const char* initial_sampler = (p.initial_sampler == nsgaii::InitialSampler::LatinHypercube) ? "LatinHypercube" : "Uniform";
+    const char* crossover_mode = (p.crossover_mode == nsgaii::CrossoverMode::Batch) ? "Batch" : "PerPair";
+
+    std::ostringstream os;
+    os << "#pragma once\n\n"
+       << "// param_bakerが " << config_file_path << " から生成したファイル（編集しない）\n\n"
+       << "#include <array>\n\n"
+       << "#include \"nsgaii.hpp\"\n\n"
+       << "namespace charge_schedule\n{\n    namespace baked\n    {\n"
+       << "        constexpr int visited_number = " << p.visited_number << ";\n"
+       << "        constexpr std::array<float, visited_number> T_move = " << floatArray(p.T_move) << ";\n"
+       << "        constexpr std::array<float, visited_number> T_standby = " << floatArray(p.T_standby) << ";\n"
+       << "        constexpr std::array<float, visited_number> T_cs = " << floatArray(p.T_cs) << ";\n"
+       << "        constexpr std::array<float, visited_number> E_move = " << floatArray(p.E_move) << ";\n"
+       << "        constexpr std::array<float, visited_number> E_standby = " << floatArray(p.E_standby) << ";\n"
+       << "        constexpr std::array<float, visited_number> E_cs = " << floatArray(p.E_cs) << ";\n"
+       << "        constexpr int population_size = " << p.population_size << ";\n"
+       << "        constexpr int T_max = " << p.T_max << ";\n"
+       << "        constexpr int max_charge_number = " << p.max_charge_number << ";\n"
+       << "        constexpr int W_target = " << p.W_target << ";\n"
+       << "        constexpr int SOC_Hi = " << p.SOC_Hi << ";\n"
+       << "        constexpr int SOC_Low = " << p.SOC_Low << ";\n"
+       << "        constexpr int SOC_cccv = " << p.SOC_cccv << ";\n"
+       << "        constexpr float r_cc = " << floatLiteral(p.r_cc) << ";\n"
+       << "        constexpr float r_cv = " << floatLiteral(p.r_cv) << ";\n"
+       << "        constexpr int charging_minimum = " << p.charging_minimum << ";\n"
+       << "        constexpr float eta_sbx = " << floatLiteral(p.eta_sbx) << ";\n"
+       << "        constexpr float eta_m = " << floatLiteral(p.eta_m) << ";\n"
+       << "        constexpr float mutation_probability = " << floatLiteral(p.mutation_probability) << ";\n"
+       << "        constexpr nsgaii::SurvivorSelection survivor_selection = nsgaii::SurvivorSelection::" << survivor_selection << ";\n"
+       << "        constexpr nsgaii::InitialSampler initial_sampler = nsgaii::InitialSampler::" << initial_sampler << ";\n"
+       << "        constexpr nsgaii::CrossoverMode crossover_mode = nsgaii::CrossoverMode::" << crossover_mode << ";\n"
+       << "        constexpr int worker_threads = " << p.worker_threads << ";\n"
+       << "        constexpr int initial_threads = " << p.initial_threads << ";\n"
+       << "        constexpr std::array<float, 2> hv_reference = " << floatArray({p.hv_reference.first, p.hv_reference.second}) << ";\n\n"
+       << "        constexpr bool termination_enabled = " << (t.enabled ? "true" : "false") << ";\n"
+       << "        constexpr int termination_window = " << t.window << ";\n"
+       << "        constexpr double termination_hv_tolerance = " << doubleLiteral(t.hv_tolerance) << ";\n"
+       << "        constexpr double termination_front_stability = " << doubleLiteral(t.front_stability) << ";\n"
+       << "        constexpr double termination_diversity_minimum = " << doubleLiteral(t.diversity_minimum) << ";\n"
+       << "        constexpr int termination_max_restarts = " << t.max_restarts << ";\n"
+       << "        constexpr double termination_restart_elite_ratio = " << doubleLiteral(t.restart_elite_ratio) << ";\n"
+       << "    } // namespace baked\n} // namespace charge_schedule\n";
+
+    std::ofstream output(output_path);
+    if (!output) {
+        std::cerr << "ファイルを開けませんでした: " << output_path << std::endl;
+        return 1;
+    }
+    output << os.str();
+    return 0;
+}
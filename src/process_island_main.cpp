@@ -0,0 +1,30 @@
+#include <iostream>
+#include <string>
+
+#include "process_island.hpp"
+
+// 島ごとに子プロセスを起動して島モデルを実行し，統合したパレートフロントを出力する
+// 使い方: process_island_main [島の数] [最大世代数] [移住間隔]
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+
+    charge_schedule::ProcessIslandOptions options;
+    options.island_count = (argc > 1) ? std::stoi(argv[1]) : 4;
+    options.max_generation = (argc > 2) ? std::stoi(argv[2]) : 100;
+    options.migration_interval = (argc > 3) ? std::stoi(argv[3]) : 10;
+    options.base_seed = 12345;
+
+    charge_schedule::ProcessIslandSupervisor supervisor(config_file_path, options);
+    supervisor.run();
+
+    std::vector<nsgaii::Individual> front = supervisor.mergedFront();
+    std::cout << "restarts: " << supervisor.restartCount() << std::endl;
+    std::cout << "front size: " << front.size() << std::endl;
+    std::cout << "merged hyper_volume: " << supervisor.mergedHypervolume() << std::endl;
+    std::cout << "f1,f2" << std::endl;
+    for (const auto& individual : front) {
+        std::cout << individual.f1 << "," << individual.f2 << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "chromosome_pool.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// リアルタイムモード（setRealtime）の世代ごとのメモリ確保回数と最悪の世代時間を測定する
+// 初期化（作業領域の確保と初期個体群）の後，世代ループ中のoperator newとChromosomePoolからの確保をすべて数え，
+// 1回でも確保があれば終了コード1を返す（確保しないことの確認用のフック）
+// 同じシードの通常モード（一括交叉）と最終世代の評価値が一致するか確かめ，世代時間を並べて出力する
+// 使い方: realtime_benchmark [世代数] [個体群サイズ] [最大充電回数]
+
+namespace
+{
+    struct HeapActivity
+    {
+        uint64_t allocations;      // operator new
+        uint64_t pool_allocations; // ChromosomePoolからの確保（フリーリストの再利用を含む）
+    };
+
+    HeapActivity heapActivity() {
+        nsgaii::ChromosomePool::Statistics statistics = nsgaii::ChromosomePool::statistics();
+        return {nsgaii::AllocationCounter::count(), statistics.system_allocations + statistics.reused_allocations};
+    }
+
+    void generation(charge_schedule::TwoTransProblem& nsgaii) {
+        nsgaii.generateChildren(true);
+        nsgaii.evaluatePopulation(nsgaii.children);
+        nsgaii.generateCombinedPopulation();
+        nsgaii.sortPopulation(nsgaii.combind_population);
+        nsgaii.generateParents();
+    }
+
+    void initialize(charge_schedule::TwoTransProblem& nsgaii) {
+        nsgaii.generateFirstParents();
+        nsgaii.evaluatePopulation(nsgaii.parents);
+        nsgaii.sortPopulation(nsgaii.parents);
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int generations = (argc > 1) ? std::stoi(argv[1]) : 500;
+    charge_schedule::TwoTransProblem prototype(config_file_path);
+    int population_size = (argc > 2) ? std::stoi(argv[2]) : prototype.getPopulationSize();
+    int max_charge_number = (argc > 3) ? std::stoi(argv[3]) : prototype.getMaxChargeNumber();
+
+    charge_schedule::TwoTransProblem nsgaii(prototype);
+    nsgaii.setWorkerThreads(1);
+    nsgaii.setSurvivorSelection(nsgaii::SurvivorSelection::Crowding);
+    nsgaii.setCrossoverMode(nsgaii::CrossoverMode::Batch);
+    nsgaii.setPopulationSize(population_size);
+    nsgaii.setMaxChargeNumber(max_charge_number);
+    nsgaii.setSeed(42);
+
+    // 初期化: 作業領域の確保と初期個体群（ここまでは確保してよい）
+    const uint64_t bytes_before = nsgaii::AllocationCounter::bytes();
+    nsgaii.setRealtime(true);
+    const uint64_t reserved_bytes = nsgaii::AllocationCounter::bytes() - bytes_before;
+    initialize(nsgaii);
+    std::vector<double> latencies(generations); // 計測中に伸ばさないよう先に確保する
+
+    const HeapActivity before = heapActivity();
+    uint64_t max_allocations = 0;
+    for (int g = 0; g < generations; ++g) {
+        const HeapActivity generation_before = heapActivity();
+        const auto start = std::chrono::steady_clock::now();
+        generation(nsgaii);
+        latencies[g] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const HeapActivity generation_after = heapActivity();
+        max_allocations = std::max(max_allocations, (generation_after.allocations - generation_before.allocations)
+                                                        + (generation_after.pool_allocations - generation_before.pool_allocations));
+    }
+    const HeapActivity after = heapActivity();
+    const uint64_t allocations = after.allocations - before.allocations;
+    const uint64_t pool_allocations = after.pool_allocations - before.pool_allocations;
+
+    // 同じシードの通常モードと比べる（ソートの結果が一致すれば評価値の列も一致する）
+    charge_schedule::TwoTransProblem reference(prototype);
+    reference.setWorkerThreads(1);
+    reference.setSurvivorSelection(nsgaii::SurvivorSelection::Crowding);
+    reference.setCrossoverMode(nsgaii::CrossoverMode::Batch);
+    reference.setPopulationSize(population_size);
+    reference.setMaxChargeNumber(max_charge_number);
+    reference.setSeed(42);
+    initialize(reference);
+    double reference_total = 0;
+    double reference_worst = 0;
+    for (int g = 0; g < generations; ++g) {
+        const auto start = std::chrono::steady_clock::now();
+        generation(reference);
+        const double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        reference_total += latency;
+        reference_worst = std::max(reference_worst, latency);
+    }
+    int mismatches = 0;
+    for (size_t i = 0; i < nsgaii.parents.size(); ++i) {
+        const nsgaii::Individual& a = nsgaii.parents[i];
+        const nsgaii::Individual& b = reference.parents[i];
+        if (a.f1 != b.f1 || a.f2 != b.f2 || a.penalty != b.penalty || a.fronts_count != b.fronts_count) ++mismatches;
+    }
+
+    std::vector<double> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (double latency : latencies) total += latency;
+    auto percentile = [&sorted](double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+
+    std::cout << "population_size: " << population_size << ", max_charge_number: " << max_charge_number
+              << ", generations: " << generations << std::endl;
+    std::cout << "reserved at setRealtime: " << reserved_bytes << " bytes" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "generation latency [us]: mean " << total / generations * 1e6 << ", p50 " << percentile(0.5) * 1e6
+              << ", p99 " << percentile(0.99) * 1e6 << ", worst " << sorted.back() * 1e6
+              << " (generation " << std::max_element(latencies.begin(), latencies.end()) - latencies.begin() << ")" << std::endl;
+    std::cout << "normal mode latency [us]: mean " << reference_total / generations * 1e6 << ", worst " << reference_worst * 1e6
+              << std::defaultfloat << std::endl;
+    std::cout << "allocations in generation loop: operator new " << allocations << ", chromosome pool " << pool_allocations
+              << " (max per generation " << max_allocations << ")" << std::endl;
+    std::cout << "mismatches against normal mode: " << mismatches << std::endl;
+    return (allocations == 0 && pool_allocations == 0 && mismatches == 0) ? 0 : 1;
+}
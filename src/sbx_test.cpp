@@ -1,10 +1,9 @@
 #include <memory>
 #include <iostream>
 #include <yaml-cpp/yaml.h>
-#include <fstream>
-#include <ctime>
 
 #include "two_point_trans_schedule.hpp"
+#include "observer_sinks.hpp"
 
 void generateEtaValues(float min, float max, int steps, std::vector<float>& etaValues) {
     float stepSize = (max - min + 1) / steps;  // ステップごとの増分
@@ -14,7 +13,6 @@ void generateEtaValues(float min, float max, int steps, std::vector<float>& etaV
     }
 }
 
-void csvDebugParents(std::vector<nsgaii::Individual>& parents, int& generations, const std::string& base_csv_file_path);
 void outputscreen(std::pair<nsgaii::Individual, nsgaii::Individual>& parents,std::pair<nsgaii::Individual, nsgaii::Individual>& children);
 
 
@@ -28,12 +26,15 @@ int main()
 
    std::unique_ptr<charge_schedule::TwoTransProblem> nsgaii = std::make_unique<charge_schedule::TwoTransProblem>(config_file_path);
 
+   // 個体群のCSVの書き出しは配信スレッドで行う
+   nsgaii->addObserver(charge_schedule::csvSink(base_csv_file_path), nsgaii::ObserverDispatch::Asynchronous);
+
    int current_generation = 0;
    bool random = false;
    nsgaii->generateFirstParents();
    nsgaii->evaluatePopulation(nsgaii->parents);
    nsgaii->sortPopulation(nsgaii->parents);
-   csvDebugParents(nsgaii->parents, current_generation, base_csv_file_path);
+   nsgaii->notifyObservers(current_generation, 0);
 
    std::vector<float> etaValues;
    generateEtaValues(1, 50.0, 1, etaValues);  // 最小値0.5, 最大値100.0, ステップ数20
@@ -44,8 +45,9 @@ int main()
        nsgaii->generateChildren(random);
        nsgaii->evaluatePopulation(nsgaii->children);
        nsgaii->sortPopulation(nsgaii->children);
-       csvDebugParents(nsgaii->children, current_generation, base_csv_file_path);
+       nsgaii->notifyObservers(current_generation, 0, nsgaii->children);
    }
+   nsgaii->flushObservers();
 }
 
 void outputscreen(std::pair<nsgaii::Individual, nsgaii::Individual>& parents,std::pair<nsgaii::Individual, nsgaii::Individual>& children) {
@@ -262,61 +264,3 @@ void outputscreen(std::pair<nsgaii::Individual, nsgaii::Individual>& parents,std
     std::cout << "--- --- ---" << std::endl;
 
 }
-
-void csvDebugParents(std::vector<nsgaii::Individual>& parents, int& generations, const std::string& base_csv_file_path) {
-    // 現在の日時を取得
-    std::time_t now = std::time(nullptr);
-    char date_time[20];
-    std::strftime(date_time, sizeof(date_time), "%Y-%m-%d_%H-%M", std::localtime(&now));
-
-    // 日時を含むファイルパスを生成
-    std::string csv_file_path = base_csv_file_path + ".csv";
-
-    std::ofstream csvFile(csv_file_path, std::ios::app);
-    if (!csvFile) {
-        std::cerr << "ファイルを開けませんでした！" << std::endl;
-        return;
-    }
-
-    csvFile << "第" << generations << "世代\n";
-
-    for (const auto& individual : parents) {
-        csvFile << "f1" << "," << "f2" << "," << "first_soc" << "," << "front\n";
-        csvFile << individual.f1 << "," << individual.f2 << "," << individual.first_soc << "," << individual.fronts_count << "\n";
-        csvFile << "time" << "\n";
-        for (size_t i = 0; i < individual.time_chromosome.size(); ++i) {
-            csvFile << individual.time_chromosome[i];
-            if (i != individual.time_chromosome.size() - 1) {
-                csvFile << ",";
-            }
-        }
-        csvFile << "\n";
-
-        // // 'soc'データを書き込む
-        csvFile << "soc" << "\n";
-        for (size_t i = 0; i < individual.soc_chromosome.size(); ++i) {
-            csvFile << individual.soc_chromosome[i];
-            if (i != individual.soc_chromosome.size() - 1) {
-                csvFile << ",";
-            }
-        }
-        csvFile << "\n";
-
-        // csvFile << "T_w" << "," << "T_o" << "," << "T_c" << "," << "T_r\n";
-        // for (auto& span : individual.T_span) {
-        //     for (auto& time : span) {
-        //         csvFile << time << ",";
-        //     }
-        //     csvFile << "\n";
-        // }
-
-        // csvFile << "W\n";
-        // for (auto& work : individual.W) {
-        //     csvFile << work << ",";
-        // }
-        // csvFile << "\n";
-        // csvFile << "\n";
-    }
-
-    csvFile.close();
-}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "schedule_protocol.hpp"
+
+// スケジュール問い合わせサーバの動作確認用クライアント
+// ロボットごとに1本の接続から要求を繰り返し送り（同時に届いた要求はサーバでまとめられる），
+// 最後にStatistics要求で遅延のパーセンタイルを表示する
+// 使い方: schedule_client [ソケットのパス] [ロボット数] [ロボットごとの要求数] [世代数]
+//         schedule_client [ソケットのパス] stats
+
+namespace
+{
+    int connectServer(const std::string& socket_path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            std::cerr << "サーバに接続できませんでした: " << socket_path << std::endl;
+            if (fd >= 0) ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    bool printStatistics(const std::string& socket_path) {
+        int fd = connectServer(socket_path);
+        if (fd < 0) return false;
+        charge_schedule::protocol::FrameHeader header;
+        std::vector<uint8_t> payload;
+        bool ok = charge_schedule::protocol::writeFrame(fd, charge_schedule::protocol::kRequestMagic, charge_schedule::protocol::MessageType::Statistics, {})
+               && charge_schedule::protocol::readFrame(fd, charge_schedule::protocol::kReplyMagic, header, payload);
+        ::close(fd);
+        if (ok) {
+            std::cout << std::string(payload.begin(), payload.end());
+        }
+        return ok;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string socket_path = (argc > 1) ? argv[1] : "/tmp/charge_schedule.sock";
+    if (argc > 2 && std::string(argv[2]) == "stats") {
+        return printStatistics(socket_path) ? 0 : 1;
+    }
+    int robot_count = (argc > 2) ? std::stoi(argv[2]) : 8;
+    int request_count = (argc > 3) ? std::stoi(argv[3]) : 5;
+    int generations = (argc > 4) ? std::stoi(argv[4]) : 20;
+
+    std::vector<std::thread> robots;
+    std::vector<int> failures(robot_count, 0);
+    for (int r = 0; r < robot_count; ++r) {
+        robots.emplace_back([&, r]() {
+            int fd = connectServer(socket_path);
+            if (fd < 0) {
+                failures[r] = request_count;
+                return;
+            }
+            for (int k = 0; k < request_count; ++k) {
+                charge_schedule::protocol::ScheduleRequestData request{};
+                request.header.robot_id = r;
+                request.header.visited_number = 0; // サーバのYAMLのパラメータを使う
+                request.header.generations = generations;
+                request.header.first_soc = static_cast<uint8_t>(100 - 5 * (k % 4));
+
+                std::vector<uint8_t> payload;
+                charge_schedule::protocol::encodeScheduleRequest(request, payload);
+                charge_schedule::protocol::FrameHeader header;
+                charge_schedule::protocol::ScheduleReply reply;
+                std::vector<charge_schedule::protocol::FrontEntry> front;
+                auto start = std::chrono::steady_clock::now();
+                if (!charge_schedule::protocol::writeFrame(fd, charge_schedule::protocol::kRequestMagic, charge_schedule::protocol::MessageType::Schedule, payload)
+                    || !charge_schedule::protocol::readFrame(fd, charge_schedule::protocol::kReplyMagic, header, payload)
+                    || !charge_schedule::protocol::decodeScheduleReply(payload, reply, front)
+                    || reply.status != static_cast<uint16_t>(charge_schedule::protocol::ReplyStatus::Ok)) {
+                    ++failures[r];
+                    continue;
+                }
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << "robot " << reply.robot_id << ": front " << reply.front_size << (reply.warm ? " (warm)" : " (cold)")
+                          << ", round trip " << 1000.0 * seconds << " ms, reply " << payload.size() << " bytes\n";
+            }
+            ::close(fd);
+        });
+    }
+    int total_failures = 0;
+    for (int r = 0; r < robot_count; ++r) {
+        robots[r].join();
+        total_failures += failures[r];
+    }
+    std::cout << "failures: " << total_failures << std::endl;
+    printStatistics(socket_path);
+    return total_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "front_index.hpp"
+#include "schedule_message.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// 充電計画メッセージ（schedule_message.hpp）の書き込み・その場参照・復号の処理量を測定する
+// 評価済みの個体群を1つの連続した領域へ次々に書き込み（多数のロボットへの一斉配車を想定），
+// その領域をビューで走査する・DecodedScheduleへ復号する時間を比べ，往復で値が一致するかを確かめる
+// 使い方: schedule_message_benchmark [最大充電回数] [繰り返し回数]
+
+namespace
+{
+    void report(const std::string& name, double seconds, size_t messages, size_t bytes) {
+        std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(1)
+                  << seconds * 1e9 / messages << " ns/message, " << std::setprecision(0)
+                  << messages / seconds << " messages/s, " << std::setprecision(1)
+                  << bytes / seconds / (1 << 20) << " MiB/s" << std::defaultfloat << std::endl;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int max_charge_number = (argc > 1) ? std::stoi(argv[1]) : 20;
+    int repeat = (argc > 2) ? std::stoi(argv[2]) : 200;
+
+    charge_schedule::TwoTransProblem nsgaii(config_file_path);
+    nsgaii.setSeed(42);
+    nsgaii.setMaxChargeNumber(max_charge_number);
+    nsgaii.generateFirstParents();
+    nsgaii.evaluatePopulation(nsgaii.parents);
+    const std::vector<nsgaii::Individual>& population = nsgaii.parents;
+
+    // 全個体分のメッセージを詰める領域と各メッセージの位置
+    std::vector<size_t> offsets;
+    size_t total_bytes = 0;
+    for (const nsgaii::Individual& individual : population) {
+        offsets.push_back(total_bytes);
+        total_bytes += charge_schedule::scheduleMessageSize(individual.charging_number);
+    }
+    std::vector<uint8_t> buffer(total_bytes);
+    const size_t messages = population.size() * repeat;
+    const size_t bytes = total_bytes * repeat;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r) {
+        for (size_t i = 0; i < population.size(); ++i) {
+            charge_schedule::encodeScheduleMessage(population[i], static_cast<uint32_t>(i), r, buffer.data() + offsets[i], buffer.size() - offsets[i]);
+        }
+    }
+    double encode_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // ビュー: ヘッダを確かめ，全充電の値をその場で読む
+    double checksum = 0;
+    charge_schedule::ScheduleMessageView view;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r) {
+        for (size_t i = 0; i < population.size(); ++i) {
+            view.reset(buffer.data() + offsets[i], buffer.size() - offsets[i]);
+            for (int c = 0; c < view.chargeCount(); ++c) {
+                const charge_schedule::ScheduleCharge& charge = view.charge(c);
+                checksum += charge.departure + charge.return_time + charge.target_soc;
+            }
+        }
+    }
+    double view_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<charge_schedule::DecodedSchedule> decoded(population.size());
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r) {
+        for (size_t i = 0; i < population.size(); ++i) {
+            charge_schedule::decodeScheduleMessage(buffer.data() + offsets[i], buffer.size() - offsets[i], decoded[i]);
+        }
+    }
+    double decode_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 往復の照合
+    int mismatches = 0;
+    for (size_t i = 0; i < population.size(); ++i) {
+        const nsgaii::Individual& individual = population[i];
+        const charge_schedule::DecodedSchedule& schedule = decoded[i];
+        bool same = schedule.f1 == individual.f1 && schedule.f2 == individual.f2 && schedule.first_soc == individual.first_soc
+                    && schedule.charging_number == individual.charging_number;
+        for (int c = 0; same && c < individual.charging_number; ++c) {
+            same = schedule.charge_time[c] == individual.time_chromosome[c] && schedule.target_soc[c] == individual.soc_chromosome[c]
+                   && schedule.charging_position[c] == individual.charging_position[c] && schedule.return_position[c] == individual.return_position[c]
+                   && schedule.cycle_count[c] == individual.cycle_count[c] && schedule.T_span[c] == individual.T_span[c];
+        }
+        if (!same) ++mismatches;
+    }
+
+    std::cout << "messages: " << population.size() << " × " << repeat << ", mean size: " << total_bytes / population.size()
+              << " bytes (checksum " << checksum << ")" << std::endl;
+    report("encode", encode_seconds, messages, bytes);
+    report("view", view_seconds, messages, bytes);
+    report("decode", decode_seconds, messages, bytes);
+    std::cout << "round trip mismatches: " << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
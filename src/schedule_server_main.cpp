@@ -0,0 +1,40 @@
+#include <csignal>
+#include <iostream>
+#include <string>
+
+#include "schedule_server.hpp"
+
+// スケジュール問い合わせサーバを起動する（SIGINT・SIGTERMで終了）
+// 使い方: schedule_server [ソケットのパス] [まとめる時間 ms] [スレッド数（0: ハードウェアのスレッド数）]
+
+namespace
+{
+    charge_schedule::ScheduleServer* running_server = nullptr;
+
+    void handleSignal(int) {
+        if (running_server != nullptr) {
+            running_server->stop();
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+
+    charge_schedule::ServerOptions options;
+    if (argc > 1) options.socket_path = argv[1];
+    if (argc > 2) options.batch_window_ms = std::stoi(argv[2]);
+    if (argc > 3) options.thread_count = std::stoi(argv[3]);
+
+    charge_schedule::ScheduleServer server(config_file_path, options);
+    running_server = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "listening on " << options.socket_path << std::endl;
+    server.serve();
+    running_server = nullptr;
+    std::cout << server.statisticsText();
+    return 0;
+}
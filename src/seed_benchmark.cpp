@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quality_indicators.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// 複数のシードでTwoTransProblemを同じ評価回数だけ並列に実行し，品質指標の中央値と
+// 95%信頼区間を出力する．ベースラインファイルと比較して性能の劣化を検出する
+//
+// 使い方: seed_benchmark [--seeds N] [--evaluations E] [--threads T] [--target HV]
+//                        [--reference-front file] [--write-baseline file]
+//                        [--baseline file] [--tolerance r]
+
+struct SeedResult
+{
+    unsigned int seed;
+    std::vector<nsgaii::ObjectivePoint> front;
+    double hypervolume;
+    double igd;
+    double spread;
+    double time_to_target;        // 目標ハイパーボリュームへの到達時間 [s]（未到達はinf）
+    long evaluations_to_target;   // 目標ハイパーボリュームへの到達評価回数（未到達は-1）
+    double elapsed_seconds;
+    std::vector<std::pair<double, double>> hv_trace; // (経過時間, アーカイブHV)
+};
+
+struct Baseline
+{
+    std::map<std::string, nsgaii::SummaryStatistics> metrics;
+    std::vector<nsgaii::ObjectivePoint> reference_front;
+    double target = 0;
+};
+
+std::vector<nsgaii::ObjectivePoint> loadFront(const std::string& file_path);
+bool loadBaseline(const std::string& file_path, Baseline& baseline);
+void writeBaseline(const std::string& file_path, const std::map<std::string, nsgaii::SummaryStatistics>& metrics,
+                   const std::vector<nsgaii::ObjectivePoint>& reference_front, double target, int seeds, long evaluations);
+
+int main(int argc, char** argv)
+{
+    std::string config_file_path = "../params/two_charge_schedule.yaml";
+    int seed_count = 10;
+    long evaluation_budget = 20000;
+    int thread_count = std::max(1u, std::thread::hardware_concurrency());
+    double target = -1;
+    double tolerance = 0.01;
+    std::string reference_front_path;
+    std::string baseline_path;
+    std::string write_baseline_path;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string key = argv[i];
+        std::string value = argv[i + 1];
+        if (key == "--seeds") seed_count = std::stoi(value);
+        else if (key == "--evaluations") evaluation_budget = std::stol(value);
+        else if (key == "--threads") thread_count = std::stoi(value);
+        else if (key == "--target") target = std::stod(value);
+        else if (key == "--tolerance") tolerance = std::stod(value);
+        else if (key == "--reference-front") reference_front_path = value;
+        else if (key == "--baseline") baseline_path = value;
+        else if (key == "--write-baseline") write_baseline_path = value;
+        else {
+            std::cerr << "不明なオプションです: " << key << std::endl;
+            return 2;
+        }
+    }
+
+    Baseline baseline;
+    bool has_baseline = !baseline_path.empty() && loadBaseline(baseline_path, baseline);
+    if (!baseline_path.empty() && !has_baseline) {
+        std::cerr << "ベースラインを読み込めませんでした: " << baseline_path << std::endl;
+        return 2;
+    }
+
+    charge_schedule::TwoTransProblem prototype(config_file_path);
+    std::pair<float, float> reference = prototype.hypervolumeReference();
+    int population_size = prototype.getPopulationSize();
+
+    // 各シードを同じ評価回数で実行（初期個体群の評価を含む）
+    std::vector<SeedResult> results(seed_count);
+    std::atomic<int> next_seed(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < std::min(thread_count, seed_count); ++t) {
+        workers.emplace_back([&]() {
+            int index;
+            while ((index = next_seed.fetch_add(1)) < seed_count) {
+                auto start = std::chrono::steady_clock::now();
+                SeedResult& result = results[index];
+                result.seed = 1000u + static_cast<unsigned int>(index);
+
+                charge_schedule::TwoTransProblem nsgaii(prototype);
+                nsgaii.setSeed(result.seed);
+                nsgaii.resetArchiveHypervolume();
+                nsgaii.setInitialThreads(1); // シードごとにワーカーが並列に走るため逐次に生成する
+                nsgaii.generateFirstParents();
+                nsgaii.evaluatePopulation(nsgaii.parents);
+                nsgaii.sortPopulation(nsgaii.parents);
+                long evaluations = population_size;
+                double hv = nsgaii.updateArchiveHypervolume(nsgaii.parents);
+                result.hv_trace.emplace_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), hv);
+
+                while (evaluations + population_size <= evaluation_budget) {
+                    nsgaii.generateChildren(true);
+                    nsgaii.evaluatePopulation(nsgaii.children);
+                    nsgaii.generateCombinedPopulation();
+                    nsgaii.sortPopulation(nsgaii.combind_population);
+                    nsgaii.generateParents();
+                    evaluations += population_size;
+                    hv = nsgaii.updateArchiveHypervolume(nsgaii.children);
+                    result.hv_trace.emplace_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), hv);
+                }
+
+                result.front = nsgaii::nondominatedPoints(nsgaii.parents);
+                result.hypervolume = nsgaii::hypervolume(result.front, reference.first, reference.second);
+                result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // 参照フロント: 指定ファイル > ベースライン > 全シードの統合フロント
+    std::vector<nsgaii::ObjectivePoint> reference_front;
+    if (!reference_front_path.empty()) {
+        reference_front = nsgaii::nondominatedPoints(loadFront(reference_front_path));
+    } else if (has_baseline && !baseline.reference_front.empty()) {
+        reference_front = baseline.reference_front;
+    } else {
+        std::vector<nsgaii::ObjectivePoint> all_points;
+        for (const auto& result : results) {
+            all_points.insert(all_points.end(), result.front.begin(), result.front.end());
+        }
+        reference_front = nsgaii::nondominatedPoints(all_points);
+    }
+
+    // 目標ハイパーボリューム: 指定値 > ベースライン > 参照フロントの99%
+    if (target < 0) {
+        target = (has_baseline && baseline.target > 0)
+            ? baseline.target
+            : 0.99 * nsgaii::hypervolume(reference_front, reference.first, reference.second);
+    }
+
+    std::vector<double> hv_values, igd_values, spread_values, ttt_values, elapsed_values;
+    for (auto& result : results) {
+        result.igd = nsgaii::invertedGenerationalDistance(result.front, reference_front);
+        result.spread = nsgaii::spread(result.front, reference_front);
+        result.time_to_target = std::numeric_limits<double>::infinity();
+        result.evaluations_to_target = -1;
+        for (size_t g = 0; g < result.hv_trace.size(); ++g) {
+            if (result.hv_trace[g].second >= target) {
+                result.time_to_target = result.hv_trace[g].first;
+                result.evaluations_to_target = static_cast<long>(g + 1) * population_size;
+                break;
+            }
+        }
+        hv_values.push_back(result.hypervolume);
+        igd_values.push_back(result.igd);
+        spread_values.push_back(result.spread);
+        ttt_values.push_back(result.time_to_target);
+        elapsed_values.push_back(result.elapsed_seconds);
+    }
+
+    std::map<std::string, nsgaii::SummaryStatistics> metrics;
+    metrics["hypervolume"] = nsgaii::summarize(hv_values);
+    metrics["igd"] = nsgaii::summarize(igd_values);
+    metrics["spread"] = nsgaii::summarize(spread_values);
+    metrics["time_to_target"] = nsgaii::summarize(ttt_values);
+    metrics["elapsed"] = nsgaii::summarize(elapsed_values);
+
+    std::cout << "seed,hypervolume,igd,spread,time_to_target_s,evaluations_to_target,elapsed_s" << std::endl;
+    for (const auto& result : results) {
+        std::cout << result.seed << "," << result.hypervolume << "," << result.igd << "," << result.spread << ","
+                  << result.time_to_target << "," << result.evaluations_to_target << "," << result.elapsed_seconds << std::endl;
+    }
+    std::cout << std::endl;
+    std::cout << "seeds: " << seed_count << ", evaluations: " << evaluation_budget << ", target hv: " << target << std::endl;
+    std::cout << "metric,median,ci95_lower,ci95_upper" << std::endl;
+    for (const auto& metric : metrics) {
+        std::cout << metric.first << "," << metric.second.median << "," << metric.second.lower << "," << metric.second.upper << std::endl;
+    }
+
+    if (!write_baseline_path.empty()) {
+        writeBaseline(write_baseline_path, metrics, reference_front, target, seed_count, evaluation_budget);
+    }
+
+    // 回帰判定: 中央値が許容量を超えて悪化し，かつ信頼区間がベースラインの中央値を含まない場合
+    int regressions = 0;
+    if (has_baseline) {
+        std::cout << std::endl << "--- regression check ---" << std::endl;
+        const std::vector<std::pair<std::string, bool>> checks = {
+            {"hypervolume", true}, {"igd", false}, {"spread", false}, {"time_to_target", false}};
+        for (const auto& check : checks) {
+            auto current = metrics.find(check.first);
+            auto base = baseline.metrics.find(check.first);
+            if (current == metrics.end() || base == baseline.metrics.end()) continue;
+            const nsgaii::SummaryStatistics& now = current->second;
+            const nsgaii::SummaryStatistics& before = base->second;
+            bool higher_is_better = check.second;
+            bool worse = higher_is_better
+                ? (now.median < before.median * (1.0 - tolerance) && now.upper < before.median)
+                : (now.median > before.median * (1.0 + tolerance) && now.lower > before.median);
+            std::cout << check.first << ": " << before.median << " -> " << now.median << (worse ? "  REGRESSION" : "  ok") << std::endl;
+            if (worse) ++regressions;
+        }
+    }
+    return (regressions > 0) ? 1 : 0;
+}
+
+std::vector<nsgaii::ObjectivePoint> loadFront(const std::string& file_path) {
+    std::vector<nsgaii::ObjectivePoint> front;
+    std::ifstream file(file_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream stream(line);
+        float f1, f2;
+        if (stream >> f1 >> f2) {
+            front.emplace_back(f1, f2);
+        }
+    }
+    return front;
+}
+
+bool loadBaseline(const std::string& file_path, Baseline& baseline) {
+    std::ifstream file(file_path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream stream(line);
+        std::string key;
+        stream >> key;
+        if (key == "metric") {
+            // 未到達の指標はinfとして保存されるためstodで読み込む
+            std::string name, median, lower, upper;
+            nsgaii::SummaryStatistics statistics{};
+            stream >> name >> median >> lower >> upper >> statistics.count;
+            statistics.median = std::stod(median);
+            statistics.lower = std::stod(lower);
+            statistics.upper = std::stod(upper);
+            baseline.metrics[name] = statistics;
+        } else if (key == "front") {
+            float f1, f2;
+            stream >> f1 >> f2;
+            baseline.reference_front.emplace_back(f1, f2);
+        } else if (key == "target") {
+            stream >> baseline.target;
+        }
+    }
+    return true;
+}
+
+void writeBaseline(const std::string& file_path, const std::map<std::string, nsgaii::SummaryStatistics>& metrics,
+                   const std::vector<nsgaii::ObjectivePoint>& reference_front, double target, int seeds, long evaluations) {
+    std::ofstream file(file_path);
+    if (!file) {
+        std::cerr << "ファイルを開けませんでした！" << std::endl;
+        return;
+    }
+    file << std::setprecision(9);
+    file << "# seed_benchmark baseline (seeds " << seeds << ", evaluations " << evaluations << ")\n";
+    file << "target " << target << "\n";
+    for (const auto& metric : metrics) {
+        file << "metric " << metric.first << " " << metric.second.median << " " << metric.second.lower << " "
+             << metric.second.upper << " " << metric.second.count << "\n";
+    }
+    for (const auto& point : reference_front) {
+        file << "front " << point.first << " " << point.second << "\n";
+    }
+}
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <link.h>
+#include <sys/stat.h>
+
+#include "termination.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// 起動から最初の個体群が揃うまでの時間と実行ファイルの大きさを測る
+// 同じソースをYAML版（startup_benchmark_yaml）と焼き込み版（startup_benchmark_baked）の2通りにビルドし，並べて比べる
+// 問題の構築（パラメータの読み込みを含む）はrepeat回繰り返した平均，初期個体群の生成・評価・ソートは1回
+// 使い方: startup_benchmark_{yaml,baked} [繰り返し回数]
+
+namespace
+{
+    bool yaml_loaded = false;
+
+    int findYaml(struct dl_phdr_info* info, size_t, void*) {
+        if (std::string(info->dlpi_name).find("yaml-cpp") != std::string::npos) {
+            yaml_loaded = true;
+        }
+        return 0;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const auto main_start = std::chrono::steady_clock::now();
+    int repeat = (argc > 1) ? std::stoi(argv[1]) : 100;
+
+#ifdef CHARGE_SCHEDULE_BAKED_PARAMS
+    const char* build = "baked";
+    auto construct = []() {
+        return std::make_unique<charge_schedule::TwoTransProblem>();
+    };
+    auto monitor = [](int population_size) {
+        return nsgaii::ConvergenceMonitor(charge_schedule::baked::terminationParameters(), population_size);
+    };
+#else
+    const char* build = "yaml";
+    const std::string config_file_path = "../params/two_charge_schedule.yaml";
+    auto construct = [&config_file_path]() {
+        return std::make_unique<charge_schedule::TwoTransProblem>(config_file_path);
+    };
+    auto monitor = [&config_file_path](int population_size) {
+        return nsgaii::ConvergenceMonitor(config_file_path, population_size);
+    };
+#endif
+
+    // 最初の1回（起動直後に実際に行う構築）
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<charge_schedule::TwoTransProblem> problem = construct();
+    nsgaii::ConvergenceMonitor first_monitor = monitor(problem->getPopulationSize());
+    double first_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    problem->setSeed(42);
+    problem->generateFirstParents();
+    problem->evaluatePopulation(problem->parents);
+    problem->sortPopulation(problem->parents);
+    double population_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double hypervolume = problem->updateArchiveHypervolume(problem->parents); // 2通りのビルドで一致することを確かめる
+    double ready_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - main_start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+        std::unique_ptr<charge_schedule::TwoTransProblem> repeated = construct();
+        nsgaii::ConvergenceMonitor repeated_monitor = monitor(repeated->getPopulationSize());
+        (void)repeated_monitor;
+    }
+    double construct_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+    struct stat status;
+    long long binary_bytes = (stat("/proc/self/exe", &status) == 0) ? static_cast<long long>(status.st_size) : -1;
+    dl_iterate_phdr(findYaml, nullptr);
+
+    std::cout << "build: " << build << std::endl;
+    std::cout << "first construct: " << first_seconds * 1e6 << " us, mean construct: " << construct_seconds * 1e6 << " us (" << repeat << " times)" << std::endl;
+    std::cout << "first population: " << population_seconds * 1e6 << " us, main to ready: " << ready_seconds * 1e6 << " us" << std::endl;
+    std::cout << "first population hyper_volume: " << hypervolume << std::endl;
+    std::cout << "binary: " << binary_bytes << " bytes, yaml-cpp loaded: " << (yaml_loaded ? "yes" : "no") << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "station_timeline.hpp"
+
+// StationTimelineの構築・区間の出し入れ・最大占有数の問い合わせの時間を測定する
+// 1世代で想定する規模（ロボット500台 × 充電20回）の区間を乱数で作り，
+// 評価段と同じく「自分の区間を除いて候補の区間ごとに問い合わせる」操作を繰り返す
+// 問い合わせの一部は全区間の走査による結果と照合する
+// 使い方: station_benchmark [ロボット数] [充電回数] [ステーション数]
+
+int main(int argc, char** argv)
+{
+    int robot_count = (argc > 1) ? std::stoi(argv[1]) : 500;
+    int charge_count = (argc > 2) ? std::stoi(argv[2]) : 20;
+    int station_count = (argc > 3) ? std::stoi(argv[3]) : 2;
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> work_dist(20.0f, 120.0f);
+    std::uniform_real_distribution<float> charge_dist(10.0f, 60.0f);
+    std::uniform_int_distribution<int> station_dist(0, station_count - 1);
+    std::vector<std::vector<charge_schedule::StationTimeline::Window>> robots(robot_count);
+    std::vector<charge_schedule::StationTimeline::Window> windows;
+    for (auto& robot : robots) {
+        float elapsed_time = 0;
+        for (int i = 0; i < charge_count; ++i) {
+            float begin = elapsed_time + work_dist(gen);
+            float end = begin + charge_dist(gen);
+            robot.push_back({station_dist(gen), begin, end});
+            elapsed_time = end;
+        }
+        windows.insert(windows.end(), robot.begin(), robot.end());
+    }
+
+    charge_schedule::StationTimeline timeline;
+    auto start = std::chrono::steady_clock::now();
+    timeline.build(windows, station_count);
+    for (const auto& window : windows) {
+        timeline.add(window, 1);
+    }
+    double build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // ロボットごとに自分の区間を除き，自分の候補（ずらした区間）の最大占有数を問い合わせる
+    std::uniform_real_distribution<float> shift_dist(-30.0f, 30.0f);
+    long long queries = 0;
+    long long load_sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& robot : robots) {
+        for (const auto& window : robot) timeline.add(window, -1);
+        for (const auto& window : robot) {
+            float shift = shift_dist(gen);
+            load_sum += timeline.maxLoad(window.station, window.begin + shift, window.end + shift);
+            ++queries;
+        }
+        for (const auto& window : robot) timeline.add(window, 1);
+    }
+    double query_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 全区間の走査と照合（区間の最大占有数はいずれかの区間の始点，または問い合わせの始点で達する）
+    int mismatches = 0;
+    std::uniform_real_distribution<float> time_dist(0.0f, windows.back().end);
+    for (int q = 0; q < 200; ++q) {
+        int station = station_dist(gen);
+        float begin = time_dist(gen);
+        float end = begin + charge_dist(gen);
+        std::vector<float> points = {begin};
+        for (const auto& window : windows) {
+            if (window.station == station && begin < window.begin && window.begin < end) points.push_back(window.begin);
+        }
+        int expected = 0;
+        for (float t : points) {
+            int load = 0;
+            for (const auto& window : windows) {
+                if (window.station == station && window.begin <= t && t < window.end) ++load;
+            }
+            expected = std::max(expected, load);
+        }
+        if (timeline.maxLoad(station, begin, end) != expected) ++mismatches;
+    }
+
+    std::cout << "robots,charges,stations,windows,build_seconds,queries,query_microseconds,mean_load,mismatches" << std::endl;
+    std::cout << robot_count << "," << charge_count << "," << station_count << "," << windows.size() << ","
+              << build_seconds << "," << queries << "," << 1e6 * query_seconds / queries << ","
+              << static_cast<double>(load_sum) / queries << "," << mismatches << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
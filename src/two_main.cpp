@@ -1,12 +1,13 @@
 #include <memory>
 #include <iostream>
 #include <yaml-cpp/yaml.h>
-#include <fstream>
-#include <ctime>
 
 #include "two_point_trans_schedule.hpp"
+#include "termination.hpp"
+#include "pipelined_loop.hpp"
+#include "observer_sinks.hpp"
+#include "front_index.hpp"
 
-void csvDebugParents(std::vector<nsgaii::Individual>& parents, int& generations, const std::string& base_csv_file_path);
 void outputscreen(std::pair<nsgaii::Individual, nsgaii::Individual>& parents,std::pair<nsgaii::Individual, nsgaii::Individual>& children);
 
 int main()
@@ -15,49 +16,93 @@ int main()
     std::string config_file_path = "../params/two_charge_schedule.yaml";
 
     std::unique_ptr<charge_schedule::TwoTransProblem> nsgaii = std::make_unique<charge_schedule::TwoTransProblem>(config_file_path);
+    nsgaii::ConvergenceMonitor monitor(config_file_path, nsgaii->parents.size());
 
     int current_generation = 0;
     bool random = true;
     int max_generation = 100;
-    // float f1_reference = 200;
-    // float f2_reference = 100;
-    // float hyper_volume = 0;
-    // std::vector<nsgaii::Individual> pareto_front;
+    double hyper_volume = 0;
+
+    // パイプライン実行（評価・ソートを子の生成と並行に行う．省略時は逐次）
+    std::unique_ptr<charge_schedule::PipelinedLoop> pipeline;
+    YAML::Node pipeline_config = YAML::LoadFile(config_file_path)["pipeline"];
+    if (pipeline_config && pipeline_config["enabled"].as<bool>()) {
+        pipeline = std::make_unique<charge_schedule::PipelinedLoop>(*nsgaii, pipeline_config["queue_capacity"].as<size_t>());
+    }
+
+    // 世代ごとの観測者（CSVの書き出しは配信スレッドで子の生成と並行に行う）
+    charge_schedule::MetricsSink metrics;
+    nsgaii->addObserver(charge_schedule::csvSink(base_csv_file_path), nsgaii::ObserverDispatch::Asynchronous);
+    nsgaii->addObserver(metrics.observer());
+
+    // 全世代の非支配解アーカイブ（終了後に膝点などを問い合わせる）
+    charge_schedule::FrontIndex front_index;
+    nsgaii->addObserver([&front_index](const nsgaii::GenerationView& view) {
+        if (view.frontCount() > 0) {
+            for (int index : view.front(0)) {
+                front_index.add(view[index]);
+            }
+        }
+    });
+
+    // 第1前線の共有メモリへの公開（省略時は公開しない）
+    YAML::Node publisher_config = YAML::LoadFile(config_file_path)["front_publisher"];
+    if (publisher_config && publisher_config["enabled"].as<bool>()) {
+        auto publisher = std::make_shared<charge_schedule::FrontPublisher>(publisher_config["name"].as<std::string>(), publisher_config["capacity"].as<uint32_t>());
+        nsgaii->addObserver(charge_schedule::sharedMemorySink(publisher));
+    }
 
     nsgaii->generateFirstParents();
     nsgaii->evaluatePopulation(nsgaii->parents);
     nsgaii->sortPopulation(nsgaii->parents);
 
-    // for (int i = 0; i < nsgaii->parents.size(); ++i) {
-    //     if (nsgaii->parents[i].fronts_count > 0) break;
-    //     pareto_front.emplace_back(nsgaii->parents[i]);
-    // }
-    // hyper_volume = nsgaii->calculateHypervolume(pareto_front, f1_reference, f2_reference);
-    // std::cout << current_generation << ". hyper_volume: " << hyper_volume << std::endl;
+    hyper_volume = nsgaii->updateArchiveHypervolume(nsgaii->parents);
+    std::cout << current_generation << ". hyper_volume: " << hyper_volume << std::endl;
+    nsgaii->notifyObservers(current_generation, hyper_volume);
 
     while (current_generation < max_generation) {
-        csvDebugParents(nsgaii->parents, current_generation, base_csv_file_path);
-
         // if (current_generation > 50) {
             // random = false;
             // nsgaii->setEtaSBX(20);
             // nsgaii->setEtaM(50);
         // }
-        nsgaii->generateChildren(random);
-        nsgaii->evaluatePopulation(nsgaii->children);
-        nsgaii->generateCombinedPopulation();
-        nsgaii->sortPopulation(nsgaii->combind_population);
-        nsgaii->generateParents();
+        if (pipeline) {
+            pipeline->step(random);
+        } else {
+            nsgaii->generateChildren(random);
+            nsgaii->evaluatePopulation(nsgaii->children);
+            nsgaii->generateCombinedPopulation();
+            nsgaii->sortPopulation(nsgaii->combind_population);
+            nsgaii->generateParents();
+        }
 
-        // for (int i = 0; i < nsgaii->parents.size(); ++i) {
-        //     if (nsgaii->parents[i].fronts_count > 0) break;
-        //     pareto_front.emplace_back(nsgaii->parents[i]);
-        // }
-        // hyper_volume = nsgaii->calculateHypervolume(pareto_front, f1_reference, f2_reference);
-        // std::cout << current_generation << ". hyper_volume: " << hyper_volume << std::endl;
+        // 子個体のみを差分でアーカイブへ追加
+        hyper_volume = nsgaii->updateArchiveHypervolume(nsgaii->children);
+        std::cout << current_generation << ". hyper_volume: " << hyper_volume << std::endl;
         ++current_generation;
+
+        nsgaii::TerminationStatus status = monitor.update(nsgaii->parents, hyper_volume);
+        if (status == nsgaii::TerminationStatus::Restart) {
+            std::cout << current_generation << ". partial restart" << std::endl;
+            monitor.addEvaluations(nsgaii->partialRestart(monitor.eliteSize()));
+        }
+        nsgaii->notifyObservers(current_generation, hyper_volume);
+        if (status == nsgaii::TerminationStatus::Converged) {
+            break;
+        }
+    }
+    monitor.printReport(std::cout, max_generation);
+    if (pipeline) {
+        pipeline->printStatistics(std::cout);
+    }
+    nsgaii->flushObservers();
+    metrics.print(std::cout);
+
+    front_index.build();
+    if (const charge_schedule::DecodedSchedule* knee = front_index.knee()) {
+        std::cout << "--- knee (archive " << front_index.size() << ") ---" << std::endl;
+        charge_schedule::printSchedule(std::cout, *knee);
     }
-    csvDebugParents(nsgaii->parents, current_generation, base_csv_file_path);
 }
 
 void outputscreen(std::pair<nsgaii::Individual, nsgaii::Individual>& parents,std::pair<nsgaii::Individual, nsgaii::Individual>& children) {
@@ -274,61 +319,3 @@ void outputscreen(std::pair<nsgaii::Individual, nsgaii::Individual>& parents,std
     std::cout << "--- --- ---" << std::endl;
 
 }
-
-void csvDebugParents(std::vector<nsgaii::Individual>& parents, int& generations, const std::string& base_csv_file_path) {
-    // 現在の日時を取得
-    std::time_t now = std::time(nullptr);
-    char date_time[20];
-    std::strftime(date_time, sizeof(date_time), "%Y-%m-%d_%H-%M", std::localtime(&now));
-
-    // 日時を含むファイルパスを生成
-    std::string csv_file_path = base_csv_file_path + "_" + date_time + ".csv";
-
-    std::ofstream csvFile(csv_file_path, std::ios::app);
-    if (!csvFile) {
-        std::cerr << "ファイルを開けませんでした！" << std::endl;
-        return;
-    }
-
-    csvFile << "第" << generations << "世代\n";
-
-    for (const auto& individual : parents) {
-        csvFile << "f1" << "," << "f2" << "," << "first_soc" << "," << "front\n";
-        csvFile << individual.f1 << "," << individual.f2 << "," << individual.first_soc << "," << individual.fronts_count << "\n";
-        csvFile << "time" << "\n";
-        for (size_t i = 0; i < individual.time_chromosome.size(); ++i) {
-            csvFile << individual.time_chromosome[i];
-            if (i != individual.time_chromosome.size() - 1) {
-                csvFile << ",";
-            }
-        }
-        csvFile << "\n";
-
-        // // 'soc'データを書き込む
-        csvFile << "soc" << "\n";
-        for (size_t i = 0; i < individual.soc_chromosome.size(); ++i) {
-            csvFile << individual.soc_chromosome[i];
-            if (i != individual.soc_chromosome.size() - 1) {
-                csvFile << ",";
-            }
-        }
-        csvFile << "\n";
-
-        // csvFile << "T_w" << "," << "T_o" << "," << "T_c" << "," << "T_r\n";
-        // for (auto& span : individual.T_span) {
-        //     for (auto& time : span) {
-        //         csvFile << time << ",";
-        //     }
-        //     csvFile << "\n";
-        // }
-
-        // csvFile << "W\n";
-        // for (auto& work : individual.W) {
-        //     csvFile << work << ",";
-        // }
-        // csvFile << "\n";
-        // csvFile << "\n";
-    }
-
-    csvFile.close();
-}
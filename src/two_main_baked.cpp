@@ -0,0 +1,48 @@
+#include <iostream>
+#include <memory>
+
+#include "termination.hpp"
+#include "two_point_trans_schedule.hpp"
+
+// 焼き込み版（CHARGE_SCHEDULE_BAKED_PARAMS）の最適化
+// パラメータはビルド時にparam_bakerがYAMLから生成した定数を使い，実行時にはyaml-cppもYAMLファイルも使わない
+// 世代ループはtwo_mainの逐次実行と同じ（CSV・パイプライン・共有メモリへの公開は行わない）
+
+int main()
+{
+    std::unique_ptr<charge_schedule::TwoTransProblem> nsgaii = std::make_unique<charge_schedule::TwoTransProblem>();
+    nsgaii::ConvergenceMonitor monitor(charge_schedule::baked::terminationParameters(), nsgaii->parents.size());
+
+    int current_generation = 0;
+    bool random = true;
+    int max_generation = 100;
+    double hyper_volume = 0;
+
+    nsgaii->generateFirstParents();
+    nsgaii->evaluatePopulation(nsgaii->parents);
+    nsgaii->sortPopulation(nsgaii->parents);
+
+    hyper_volume = nsgaii->updateArchiveHypervolume(nsgaii->parents);
+    std::cout << current_generation << ". hyper_volume: " << hyper_volume << std::endl;
+
+    while (current_generation < max_generation) {
+        nsgaii->generateChildren(random);
+        nsgaii->evaluatePopulation(nsgaii->children);
+        nsgaii->generateCombinedPopulation();
+        nsgaii->sortPopulation(nsgaii->combind_population);
+        nsgaii->generateParents();
+
+        hyper_volume = nsgaii->updateArchiveHypervolume(nsgaii->children);
+        std::cout << current_generation << ". hyper_volume: " << hyper_volume << std::endl;
+        ++current_generation;
+
+        nsgaii::TerminationStatus status = monitor.update(nsgaii->parents, hyper_volume);
+        if (status == nsgaii::TerminationStatus::Restart) {
+            std::cout << current_generation << ". partial restart" << std::endl;
+            monitor.addEvaluations(nsgaii->partialRestart(monitor.eliteSize()));
+        } else if (status == nsgaii::TerminationStatus::Converged) {
+            break;
+        }
+    }
+    monitor.printReport(std::cout, max_generation);
+}